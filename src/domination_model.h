@@ -0,0 +1,94 @@
+#pragma once
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "graph/context.h"
+#include "graph/csr_graph.h"
+#include "graph/subgraph_view.h"
+#include "util/epoch_marker.h"
+
+//Dominating set model of a (sub)graph of mds_context, shared by the SAT and the ILP solver: a 0/1 variable for every
+//undetermined vertex, and for every vertex which is not dominated yet a covering constraint over its closed neighborhood.
+//newToOldIndex[i] is the vertex of mds_context for vertex i of the graph.
+namespace domination_model {
+    //variable_of[i] is the variable of vertex i (-1 without one), vertex_of[x] is the vertex of variable x.
+    struct variables {
+        std::vector<int> variable_of;
+        std::vector<int> vertex_of;
+    };
+
+    inline variables create_variables(MDS_CONTEXT& mds_context, int num_vertices, const std::vector<int>& newToOldIndex) {
+        variables vars;
+        vars.variable_of.assign(num_vertices, -1);
+        for (int i = 0; i < num_vertices; ++i) {
+            if (mds_context.is_undetermined(newToOldIndex[i])) {
+                vars.variable_of[i] = static_cast<int>(vars.vertex_of.size());
+                vars.vertex_of.push_back(i);
+            }
+        }
+        return vars;
+    }
+
+    //for_each_neighbor(i, f) calls f(u) for every neighbor u of vertex i, parallel edges and self loops are skipped here.
+    //on_constraint(i, row) is called for every vertex i which is not dominated, row holds the variables of its closed
+    //neighborhood (each once, the variable of i first).
+    template <typename F, typename C>
+    void for_each_constraint(MDS_CONTEXT& mds_context, int num_vertices, F&& for_each_neighbor, const std::vector<int>& newToOldIndex,
+                             const variables& vars, C&& on_constraint) {
+        EPOCH_MARKER seen;
+        std::vector<int> row;
+        for (int i = 0; i < num_vertices; ++i) {
+            if (mds_context.is_dominated(newToOldIndex[i])) {
+                continue; //dominated vertices do not need a constraint.
+            }
+            row.clear();
+            if (vars.variable_of[i] != -1) {
+                row.push_back(vars.variable_of[i]);
+            }
+            seen.clear(num_vertices);
+            seen.insert(i);
+            for_each_neighbor(i, [&](int neighbor) {
+                if (seen.contains(neighbor)) {
+                    return;
+                }
+                seen.insert(neighbor);
+                if (vars.variable_of[neighbor] != -1) {
+                    if (mds_context.is_removed(newToOldIndex[neighbor])) {
+                        throw std::runtime_error("removed vertex in the model");
+                    }
+                    row.push_back(vars.variable_of[neighbor]);
+                }
+            });
+            if (row.empty()) {
+                std::cout << "is_bad" << std::endl;
+            }
+            on_constraint(i, row);
+        }
+    }
+
+    //for_each_neighbor of the graph types the solvers take.
+    inline auto neighbors_of(const CSR_GRAPH& graph) {
+        return [&graph](int v, auto&& f) {
+            for (auto [neigh_itt, neigh_itt_end] = graph.get_neighborhood(v); neigh_itt != neigh_itt_end; ++neigh_itt) {
+                f(static_cast<int>(*neigh_itt));
+            }
+        };
+    }
+
+    inline auto neighbors_of(adjacencyListBoost& graph) {
+        return [&graph](int v, auto&& f) {
+            for (auto [neigh_itt, neigh_itt_end] = boost::adjacent_vertices(v, graph); neigh_itt != neigh_itt_end; ++neigh_itt) {
+                f(static_cast<int>(*neigh_itt));
+            }
+        };
+    }
+
+    inline auto neighbors_of(const SUBGRAPH_VIEW& view) {
+        return [&view](int v, auto&& f) {
+            for (auto [neigh_itt, neigh_itt_end] = view.neighbors(v); neigh_itt != neigh_itt_end; ++neigh_itt) {
+                f(*neigh_itt);
+            }
+        };
+    }
+}
@@ -0,0 +1,177 @@
+#include "candidate_pairs.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "../util/parallel.h"
+
+CANDIDATE_PAIRS::CANDIDATE_PAIRS(MDS_CONTEXT& mds_context) : mds_context(mds_context), num_watch_entries(0) {
+    logged.clear(mds_context.get_total_vertices());
+    mds_context.subscribe_changes(&incoming, &logged);
+}
+
+CANDIDATE_PAIRS::~CANDIDATE_PAIRS() {
+    mds_context.unsubscribe_changes(&incoming);
+}
+
+void CANDIDATE_PAIRS::build(int num_threads) {
+    if (num_threads <= 1) {
+        return;
+    }
+    update();
+    std::vector<int> missing;
+    for (int v : mds_context.undetermined_set) {
+        if (!lists[v].valid) {
+            missing.push_back(v);
+        }
+    }
+    std::sort(missing.begin(), missing.end());
+
+    //each thread searches every num_threads-th vertex, the results are stored in vertex order afterwards.
+    struct search_result {
+        int v;
+        std::size_t found_end;
+        std::size_t touched_end;
+    };
+    struct thread_output {
+        std::vector<search_result> results;
+        std::vector<int> found;
+        std::vector<int> touched;
+    };
+    std::vector<thread_output> outputs(num_threads);
+    //stop searching once the results would not fit in the budget, the rest is searched on demand.
+    std::atomic<std::size_t> total_entries(pool.size() + num_watch_entries);
+    const std::size_t max_entries = budget();
+    run_parallel(num_threads, [&](int t) {
+        search_scratch thread_scratch;
+        thread_output& output = outputs[t];
+        for (std::size_t i = t; i < missing.size(); i += num_threads) {
+            search(missing[i], thread_scratch);
+            const std::size_t entries = thread_scratch.found.size() + thread_scratch.touched_vertices.size();
+            if (total_entries.fetch_add(entries) + entries > max_entries) {
+                return;
+            }
+            output.found.insert(output.found.end(), thread_scratch.found.begin(), thread_scratch.found.end());
+            output.touched.insert(output.touched.end(), thread_scratch.touched_vertices.begin(), thread_scratch.touched_vertices.end());
+            output.results.push_back({ missing[i], output.found.size(), output.touched.size() });
+        }
+    });
+
+    std::vector<std::size_t> next(num_threads, 0);
+    std::vector<std::size_t> found_begin(num_threads, 0);
+    std::vector<std::size_t> touched_begin(num_threads, 0);
+    for (std::size_t i = 0; i < missing.size(); ++i) {
+        const int t = i % num_threads;
+        thread_output& output = outputs[t];
+        if (next[t] >= output.results.size()) {
+            continue;
+        }
+        const search_result& result = output.results[next[t]++];
+        scratch.found.assign(output.found.begin() + found_begin[t], output.found.begin() + result.found_end);
+        scratch.touched_vertices.assign(output.touched.begin() + touched_begin[t], output.touched.begin() + result.touched_end);
+        found_begin[t] = result.found_end;
+        touched_begin[t] = result.touched_end;
+        store(result.v, scratch);
+    }
+}
+
+std::pair<const int*, const int*> CANDIDATE_PAIRS::get_candidates(int v) {
+    update();
+    if (!lists[v].valid) {
+        search(v, scratch);
+        if (pool.size() + num_watch_entries + scratch.found.size() + scratch.touched_vertices.size() > budget()) {
+            reset();
+        }
+        store(v, scratch);
+    }
+    const int* begin = pool.data() + lists[v].begin;
+    return std::make_pair(begin, begin + lists[v].length);
+}
+
+void CANDIDATE_PAIRS::update() {
+    const std::size_t n = mds_context.get_total_vertices();
+    if (lists.size() < n) {
+        lists.resize(n);
+        watchers.resize(n);
+    }
+    //incoming holds every changed vertex once (see logged), it is drained here.
+    for (int u : incoming) {
+        for (auto [v, generation] : watchers[u]) {
+            if (lists[v].generation == generation) {
+                lists[v].valid = false;
+            }
+        }
+        num_watch_entries -= watchers[u].size();
+        watchers[u].clear();
+    }
+    incoming.clear();
+    logged.clear(n);
+}
+
+void CANDIDATE_PAIRS::search(int v, search_scratch& scratch) {
+    const int n = mds_context.get_total_vertices();
+    scratch.visited.clear(n);
+    scratch.touched.clear(n);
+    scratch.queue.clear();
+    scratch.found.clear();
+    scratch.touched_vertices.clear();
+
+    auto touch = [&scratch](int u) {
+        if (!scratch.touched.contains(u)) {
+            scratch.touched.insert(u);
+            scratch.touched_vertices.push_back(u);
+        }
+    };
+    scratch.visited.insert(v);
+    touch(v);
+    scratch.queue.emplace_back(v, 0);
+    for (std::size_t head = 0; head < scratch.queue.size(); ++head) {
+        auto [current, depth] = scratch.queue[head];
+        auto [neigh_itt, neigh_itt_end] = mds_context.get_neighborhood_itt(current);
+        for (; neigh_itt < neigh_itt_end; ++neigh_itt) {
+            const int neighbor = *neigh_itt;
+            touch(neighbor);
+            if (mds_context.is_excluded(neighbor) && mds_context.is_dominated(neighbor)) {
+                continue;
+            }
+            if (!scratch.visited.contains(neighbor)) {
+                scratch.visited.insert(neighbor);
+                if (mds_context.is_undetermined(neighbor)) {
+                    scratch.found.push_back(neighbor);
+                }
+                //the neighborhoods of the vertices at distance 3 are not read.
+                if (depth + 1 < 3) {
+                    scratch.queue.emplace_back(neighbor, depth + 1);
+                }
+            }
+        }
+    }
+}
+
+void CANDIDATE_PAIRS::store(int v, const search_scratch& scratch) {
+    candidate_list& list = lists[v];
+    list.begin = pool.size();
+    list.length = static_cast<std::uint32_t>(scratch.found.size());
+    list.generation++;
+    list.valid = true;
+    pool.insert(pool.end(), scratch.found.begin(), scratch.found.end());
+    for (int u : scratch.touched_vertices) {
+        watchers[u].emplace_back(v, list.generation);
+    }
+    num_watch_entries += scratch.touched_vertices.size();
+}
+
+std::size_t CANDIDATE_PAIRS::budget() {
+    return 8 * (static_cast<std::size_t>(mds_context.get_total_vertices()) + 2 * static_cast<std::size_t>(mds_context.graph.num_edges())) + (1 << 20);
+}
+
+void CANDIDATE_PAIRS::reset() {
+    for (candidate_list& list : lists) {
+        list.valid = false;
+    }
+    for (auto& watching : watchers) {
+        watching.clear();
+    }
+    num_watch_entries = 0;
+    pool.clear();
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "context.h"
+#include "../util/epoch_marker.h"
+
+//Candidate pairs of the pair rules: for each vertex v the undetermined vertices within distance 3 of v, over paths which
+//avoid excluded dominated vertices, in breadth first order (as reduce::bfs_get_distance_three).
+//the lists are kept in one pool and reused until a vertex the search from v looked at changes (its state, counters or
+//edges, see MDS_CONTEXT::subscribe_changes), then the list of v is searched again when it is asked for.
+//the pool and the reverse index (which lists depend on a vertex) are dropped as a whole when they outgrow the graph.
+class CANDIDATE_PAIRS {
+public:
+    //records the changes of mds_context from now on, no list is searched yet.
+    explicit CANDIDATE_PAIRS(MDS_CONTEXT& mds_context);
+
+    ~CANDIDATE_PAIRS();
+
+    CANDIDATE_PAIRS(const CANDIDATE_PAIRS&) = delete;
+    CANDIDATE_PAIRS& operator=(const CANDIDATE_PAIRS&) = delete;
+
+    //searches the lists of the undetermined vertices on num_threads threads (the searches only read the context).
+    //with one thread nothing is done, the lists are searched when they are asked for.
+    void build(int num_threads);
+
+    //candidates of v, valid until the next call of get_candidates or build.
+    std::pair<const int*, const int*> get_candidates(int v);
+
+private:
+    struct search_scratch {
+        EPOCH_MARKER visited;
+        EPOCH_MARKER touched;
+        std::vector<std::pair<int, int>> queue; // vertex, depth.
+        std::vector<int> found;                 // the candidates.
+        std::vector<int> touched_vertices;      // vertices whose state or neighborhood was read.
+    };
+
+    struct candidate_list {
+        std::size_t begin = 0;
+        std::uint32_t length = 0;
+        std::uint32_t generation = 0;           // watch entries of older generations are stale.
+        bool valid = false;
+    };
+
+    MDS_CONTEXT& mds_context;
+    std::vector<int> incoming;                  // change log of mds_context, without duplicates.
+    EPOCH_MARKER logged;                        // the vertices in incoming.
+    std::vector<candidate_list> lists;
+    std::vector<int> pool;
+    //watchers[u]: the lists which depend on u, with their generation when they were stored.
+    std::vector<std::vector<std::pair<int, std::uint32_t>>> watchers;
+    std::size_t num_watch_entries;
+    search_scratch scratch;
+
+    //invalidates the lists which depend on the vertices changed since the last update.
+    void update();
+
+    //bfs from v, the candidates and the touched vertices are left in scratch.
+    void search(int v, search_scratch& scratch);
+
+    void store(int v, const search_scratch& scratch);
+
+    //pool and reverse index are dropped when they are larger than this.
+    std::size_t budget();
+
+    void reset();
+};
@@ -1,30 +1,67 @@
 #pragma once
 #include "context.h"
+#include <algorithm>
 #include <vector>
+#include <cstring>
 
 MDS_CONTEXT::MDS_CONTEXT(adjacencyListBoost& g) {
-	graph = g;
 	num_nodes = boost::num_vertices(g);
+	//edges are added in the order of the edge list, so every neighborhood has the same order as in g.
+	graph = DYNAMIC_GRAPH(num_nodes);
+	for (auto [edge_it, edge_it_end] = boost::edges(g); edge_it != edge_it_end; ++edge_it) {
+		graph.add_edge(boost::source(*edge_it, g), boost::target(*edge_it, g));
+	}
+	initialize_state();
+}
 
-	selected = std::vector<bool>(num_nodes, false);
-	dominated = std::vector<bool>(num_nodes, false);
-	removed = std::vector<bool>(num_nodes, false);
-	excluded = std::vector<bool>(num_nodes, false);
-	ignored = std::vector<bool>(num_nodes, false);
+MDS_CONTEXT::MDS_CONTEXT(const SUBGRAPH_VIEW& view) {
+	num_nodes = view.num_vertices();
+	//same edge order as a component graph built from the edge list of the parent.
+	graph = DYNAMIC_GRAPH(num_nodes);
+	for (int i = 0; i < view.num_edges(); ++i) {
+		const DYNAMIC_GRAPH::edge_endpoints e = view.edge(i);
+		graph.add_edge(e.source, e.target);
+	}
+	initialize_state();
+}
 
-	c_d = std::vector<int>(num_nodes, 0);
-	c_nd = std::vector<int>(num_nodes, 0);
-	c_x = std::vector<int>(num_nodes, 0);
+MDS_CONTEXT::MDS_CONTEXT(const CSR_GRAPH& g, const std::vector<int>& vertices, const std::vector<int>& local_index) {
+	num_nodes = static_cast<int>(vertices.size());
+	//every edge once from its smaller endpoint, the order parse::construct_AdjacencyList_Boost adds them in.
+	graph = DYNAMIC_GRAPH(num_nodes);
+	for (int v : vertices) {
+		for (auto [neigh_itt, neigh_itt_end] = g.get_neighborhood(v); neigh_itt != neigh_itt_end; ++neigh_itt) {
+			if (*neigh_itt >= static_cast<std::uint32_t>(v)) {
+				graph.add_edge(local_index[v], local_index[*neigh_itt]);
+			}
+		}
+	}
+	initialize_state();
+}
+
+void MDS_CONTEXT::initialize_state() {
+	//small dense components get a bit matrix, the subset tests of the rules become word parallel.
+	graph.maybe_make_dense();
+
+	state = std::vector<std::uint8_t>(num_nodes, 0);
+	counters = std::vector<vertex_counters>(num_nodes, vertex_counters{ 0, 0, 0 });
+	undetermined_set = SPARSE_SET(num_nodes, true);
+	undominated_set = SPARSE_SET(num_nodes, true);
+	not_removed_set = SPARSE_SET(num_nodes, true);
+	cnt_dominated_excluded = 0;
 
 	cnt_sel = 0;   
 	cnt_dom = 0;   
 	cnt_excl = 0;
 	cnt_ign = 0;
 	cnt_rem = 0;
+
+	tracking = false;
+	change_logs.clear();
 }
 
 void MDS_CONTEXT::select_vertex(vertex v) {
-	selected[v] = true;
+	set_state(v, STATE_SELECTED);
 	cnt_sel++;
 	auto [neigh_itt_v, neigh_itt_v_end] = get_neighborhood_itt(v);
 	dominate_vertex(v);
@@ -34,36 +71,37 @@ void MDS_CONTEXT::select_vertex(vertex v) {
 }
 
 bool MDS_CONTEXT::is_selected(vertex v) {
-	return selected[v];
+	return state[v] & STATE_SELECTED;
 }
 
 void MDS_CONTEXT::dominate_vertex(vertex v) {
 	if (!is_dominated(v)) {
 		cnt_dom++;
-		dominated[v] = true;
+		set_state(v, STATE_DOMINATED);
 		if (!is_ignored(v)) {
-			c_nd[v]++;
+			counters[v].c_nd++;
 			auto [neigh_itt_v, neigh_itt_v_end] = get_neighborhood_itt(v);
 			for (;neigh_itt_v < neigh_itt_v_end; ++neigh_itt_v) {
-				c_nd[*neigh_itt_v]++;
+				counters[*neigh_itt_v].c_nd++;
+				record_change(*neigh_itt_v);
 			}
 		}
 	}
 }
 
 bool MDS_CONTEXT::is_dominated(vertex v) {
-	return dominated[v];
+	return state[v] & STATE_DOMINATED;
 }
 
 bool MDS_CONTEXT::is_dominated_ijcai(vertex v) {
-	return (dominated[v]  || ignored[v]);
+	return state[v] & (STATE_DOMINATED | STATE_IGNORED);
 }
 
 void MDS_CONTEXT::exclude_vertex(vertex v) {
 	if (!is_excluded(v)) {
 		cnt_excl++;
-		excluded[v] = true;
-		c_x[v]++;
+		set_state(v, STATE_EXCLUDED);
+		counters[v].c_x++;
 		auto [neigh_itt_v, neigh_itt_v_end] = get_neighborhood_itt(v);
 
 		if (!is_dominated_ijcai(v) && get_frequency(v) == 1) {
@@ -75,7 +113,8 @@ void MDS_CONTEXT::exclude_vertex(vertex v) {
 			}
 		}
 		for (auto itt = neigh_itt_v; itt < neigh_itt_v_end; ++itt) {
-			c_x[*itt]++;
+			counters[*itt].c_x++;
+			record_change(*itt);
 			if (!is_dominated_ijcai(*itt) && get_frequency(*itt) == 1) {
 				auto [neigh_itt, neigh_itt_end] = get_neighborhood_itt(*itt);
 				if (!is_excluded(*itt)) {
@@ -93,34 +132,32 @@ void MDS_CONTEXT::exclude_vertex(vertex v) {
 }
 
 bool MDS_CONTEXT::is_excluded(vertex v) {
-	return excluded[v];
+	return state[v] & STATE_EXCLUDED;
 }
 
 void MDS_CONTEXT::ignore_vertex(vertex v) {
 	if (!is_ignored(v)) {
-		ignored[v] = true;
+		set_state(v, STATE_IGNORED);
 		cnt_ign++;
 
 		//check if it isn't increased because it is already dominated.
 		if (!is_dominated(v)) {
-			c_nd[v]++;
+			counters[v].c_nd++;
 			auto [neigh_itt_v, neigh_itt_v_end] = get_neighborhood_itt(v);
 			for (;neigh_itt_v < neigh_itt_v_end; ++neigh_itt_v) {
-				c_nd[*neigh_itt_v]++;
+				counters[*neigh_itt_v].c_nd++;
+				record_change(*neigh_itt_v);
 			}
 		}
 	}
 }
 
 bool MDS_CONTEXT::is_ignored(vertex v) {
-	return ignored[v];
+	return state[v] & STATE_IGNORED;
 }
 
 bool MDS_CONTEXT::is_undetermined(vertex v) {
-	if (!is_excluded(v) && !is_selected(v)) {
-		return true;
-	}
-	return false;
+	return (state[v] & (STATE_SELECTED | STATE_EXCLUDED)) == 0;
 }
 
 //select v into solution will dominate |N[v]| - c_nd[u] more vertices.
@@ -128,42 +165,28 @@ bool MDS_CONTEXT::is_undetermined(vertex v) {
 int MDS_CONTEXT::get_coverage_size(vertex v) {
 	//v must be undetermined.
 	int num_closed_neighborhood = get_out_degree_vertex(v) + 1;
-	return num_closed_neighborhood - c_nd[v];
+	return num_closed_neighborhood - counters[v].c_nd;
 }
 
 int MDS_CONTEXT::get_frequency(vertex v) {
 	int num_closed_neighborhood = get_out_degree_vertex(v) + 1;
-	return num_closed_neighborhood - c_x[v];
-}
-
-void MDS_CONTEXT::get_lookup_l_neighborhood(std::vector<int>& l_vertices, std::unordered_set<int>& lookup_neighbourhood){
-	for (auto& v : l_vertices) {
-		auto [vertex_it, vertex_it_end] = boost::adjacent_vertices(v, graph);
-		//insert itself.
-		lookup_neighbourhood.emplace(v);
-
-		for (; vertex_it < vertex_it_end; ++vertex_it ) {
-			// if neighbour does not exist yet, insert.
-			if (lookup_neighbourhood.find(*vertex_it) == lookup_neighbourhood.end()) {
-				lookup_neighbourhood.emplace(*vertex_it);
-			}
-		}
-	}
+	return num_closed_neighborhood - counters[v].c_x;
 }
 
-void MDS_CONTEXT::get_l_neighborhood(std::vector<int>& l_vertices, std::unordered_set<int>& lookup_neighbourhood, std::vector<int>& l_neighbourhood){
+void MDS_CONTEXT::get_l_neighborhood(std::vector<int>& l_vertices, EPOCH_MARKER& lookup_neighbourhood, std::vector<int>& l_neighbourhood){
+	lookup_neighbourhood.clear(get_total_vertices());
 	for (auto& v : l_vertices) {
-		lookup_neighbourhood.emplace(v);
+		lookup_neighbourhood.insert(v);
 	}
 
 	for (auto& v : l_vertices) {
-		auto [vertex_it, vertex_it_end] = boost::adjacent_vertices(v, graph);
+		auto [vertex_it, vertex_it_end] = graph.neighbors(v);
 
 		for (; vertex_it < vertex_it_end; ++vertex_it ) {
 			// if neighbour does not exist yet, insert.
-			if (lookup_neighbourhood.find(*vertex_it) == lookup_neighbourhood.end())
+			if (!lookup_neighbourhood.contains(*vertex_it))
 			{
-				lookup_neighbourhood.emplace(*vertex_it);
+				lookup_neighbourhood.insert(*vertex_it);
 				//only check not removed vertices.
 				if (!is_selected(*vertex_it) && !(is_excluded(*vertex_it) && is_dominated(*vertex_it)) && !is_removed(*vertex_it)) {
 					l_neighbourhood.push_back(*vertex_it);
@@ -173,17 +196,17 @@ void MDS_CONTEXT::get_l_neighborhood(std::vector<int>& l_vertices, std::unordere
 	}
 }
 
-std::pair<std::vector<int>,std::vector<vertex>> MDS_CONTEXT::get_pair_neighborhood(vertex v, vertex w) {
+std::vector<vertex> MDS_CONTEXT::get_pair_neighborhood(vertex v, vertex w, EPOCH_MARKER& lookup) {
 	std::vector<vertex>pair_neighborhood_vector;
-	std::vector<int> lookup = std::vector<int>(get_total_vertices(), 0);
-	auto [vertex_v_itt, vertex_v_itt_end] = boost::adjacent_vertices(v, graph);
-	auto [vertex_w_itt, vertex_w_itt_end] = boost::adjacent_vertices(w, graph);
-	lookup[v] = 1;
-	lookup[w] = 1;
+	lookup.clear(get_total_vertices());
+	auto [vertex_v_itt, vertex_v_itt_end] = graph.neighbors(v);
+	auto [vertex_w_itt, vertex_w_itt_end] = graph.neighbors(w);
+	lookup.insert(v);
+	lookup.insert(w);
 	//add all adjacent vertices of v
 	for (;vertex_v_itt < vertex_v_itt_end; ++vertex_v_itt) {
-		if (lookup[*vertex_v_itt] == 0) { // we dont want duplicates in our pair_neighborhood_vector
-			lookup[*vertex_v_itt] = 1;
+		if (!lookup.contains(*vertex_v_itt)) { // we dont want duplicates in our pair_neighborhood_vector
+			lookup.insert(*vertex_v_itt);
 			if (is_dominated(*vertex_v_itt) && (is_selected(*vertex_v_itt))) {
 				continue;
 			}
@@ -192,94 +215,109 @@ std::pair<std::vector<int>,std::vector<vertex>> MDS_CONTEXT::get_pair_neighborho
 	}
 	//add all adjacent vertices of w
 	for (;vertex_w_itt < vertex_w_itt_end; ++vertex_w_itt) {
-		if (lookup[*vertex_w_itt] == 0) { // we dont want duplicates in our pair_neighborhood_vector
-			lookup[*vertex_w_itt] = 1;
+		if (!lookup.contains(*vertex_w_itt)) { // we dont want duplicates in our pair_neighborhood_vector
+			lookup.insert(*vertex_w_itt);
 			if (is_dominated(*vertex_w_itt) && (is_selected(*vertex_w_itt))) {
 				continue;
 			}
 			pair_neighborhood_vector.push_back(*vertex_w_itt);
 		}
 	}
-	return(std::make_pair(lookup, pair_neighborhood_vector));
+	return pair_neighborhood_vector;
 }
 
-adjacencyListBoost& MDS_CONTEXT::get_graph() {
+DYNAMIC_GRAPH& MDS_CONTEXT::get_graph() {
 	return(graph);
 }
 
 int MDS_CONTEXT::get_total_vertices() {
-	return(boost::num_vertices(graph));
+	return(graph.num_vertices());
 }
 
 vertex MDS_CONTEXT::get_vertex_from_index(int index) {
-	vertex v = boost::vertex(index, graph);
-	return v;
+	return index;
 }
 
 std::pair<vertex_itt, vertex_itt>  MDS_CONTEXT::get_vertices_itt() {
-	return (boost::vertices(graph));
+	return std::make_pair(vertex_itt(0), vertex_itt(graph.num_vertices()));
 }
 
 std::vector<vertex> MDS_CONTEXT::get_vertices() {
-	std::vector<vertex> vertices;
-	auto [vert_itt, vert_itt_end] = get_vertices_itt();
-	for (;vert_itt < vert_itt_end; ++vert_itt) {
-		if (is_undetermined(*vert_itt)) {
-			vertices.push_back(*vert_itt);
-		}
-	}
-	return vertices;
+	std::vector<int> undetermined = undetermined_set.sorted();
+	return std::vector<vertex>(undetermined.begin(), undetermined.end());
 }
 
 void MDS_CONTEXT::fill_removed_vertex() {
-	for (int counter = 0; counter < removed.size(); ++counter) {
-		if (is_dominated(counter) && is_excluded(counter)) {
-			removed[counter] = true;
-			cnt_rem++;
+	const std::uint8_t dominated_excluded = STATE_DOMINATED | STATE_EXCLUDED;
+	//every dominated and excluded vertex is counted, also the ones removed before.
+	cnt_rem += cnt_dominated_excluded;
+	std::vector<int> newly_removed;
+	for (int v : not_removed_set) {
+		if ((state[v] & dominated_excluded) == dominated_excluded) {
+			newly_removed.push_back(v);
 		}
 	}
+	for (int v : newly_removed) {
+		set_state(v, STATE_REMOVED);
+	}
 }
 
 void MDS_CONTEXT::remove_vertex(vertex v) {
 	//keep track in own list which vertices not to consider anymore.
-	removed[v] = true;
+	set_state(v, STATE_REMOVED);
 	dominate_vertex(v);
 	if (!is_selected(v)) {
 		exclude_vertex(v);
 	}
 	
-	int removed_edges = boost::out_degree(v, graph);
 	//remove all edges going out of v. (So you do not consider unnessecary vertices).
-	boost::clear_vertex(v, graph);
+	clear_vertex(v);
 	num_nodes--;
 }
 
+void MDS_CONTEXT::clear_vertex(vertex v) {
+	record_change(v);
+	if (tracking) {
+		for (auto [neigh_itt, neigh_itt_end] = graph.neighbors(v); neigh_itt != neigh_itt_end; ++neigh_itt) {
+			record_change(*neigh_itt);
+		}
+	}
+	graph.clear_vertex(v);
+}
+
 std::pair<adjacency_itt, adjacency_itt> MDS_CONTEXT::get_neighborhood_itt(vertex v) {
-	return (boost::adjacent_vertices(v, graph));
+	return (graph.neighbors(v));
 }
 
-std::pair<edge_itt, edge_itt> MDS_CONTEXT::get_edge_itt() {
-	return (boost::edges(graph));
+std::pair<context_edge_itt, context_edge_itt> MDS_CONTEXT::get_edge_itt() {
+	return (graph.edges());
 }
 
 int MDS_CONTEXT::get_total_edges() {
-	return(boost::num_edges(graph));
+	return(graph.num_edges());
 }
 
 int MDS_CONTEXT::get_out_degree_vertex(vertex v) {
-	int degree = boost::out_degree(v, graph);
-	return degree;
+	return graph.degree(v);
 }
 
 void MDS_CONTEXT::remove_edge(vertex v, vertex w) {
-	boost::remove_edge(v, w, graph);
+	record_change(v);
+	record_change(w);
+	graph.remove_edge(v, w);
+}
+
+void MDS_CONTEXT::remove_edge(vertex v, const adjacency_itt& itt) {
+	record_change(v);
+	record_change(*itt);
+	graph.remove_edge(itt);
 }
 
 //Check whether the reduction will provide profit.
 bool MDS_CONTEXT::can_be_reduced(std::vector<int>& prison_vertices) {
 	for (auto i = prison_vertices.begin(); i < prison_vertices.end(); ++i) {
 		//you need at least 1.
-		if (!dominated[*i] && !removed[*i]) {
+		if (!(state[*i] & (STATE_DOMINATED | STATE_REMOVED))) {
 			return true;
 		}
 	}
@@ -288,91 +326,217 @@ bool MDS_CONTEXT::can_be_reduced(std::vector<int>& prison_vertices) {
 }
 
 bool MDS_CONTEXT::is_removed(vertex v) {
-	if (removed[v]) {
-		return true;
-	}
-	else {
-		return false;
-	}
+	return state[v] & STATE_REMOVED;
 }
 
 bool MDS_CONTEXT::edge_exists(vertex v, vertex w) {
-	auto [edge,exists] = boost::edge(v, w, graph);
-	return exists;
+	return graph.edge_exists(v, w);
 }
 
 void MDS_CONTEXT::add_edge(vertex v, vertex w) {
-	auto new_edge = boost::add_edge(v, w, graph);
+	record_change(v);
+	record_change(w);
+	graph.add_edge(v, w);
 	return;
 }
 
 int MDS_CONTEXT::num_undetermined_vertices(){
-	int total_vertices = get_total_vertices();
-	int cnt = 0;
-	for (int i = 0; i < total_vertices; ++i)
-	{
-		if (!excluded[i] && !removed[i] && !selected[i]){
-			cnt++;
-		}
-	}
-	return cnt;
+	return undetermined_set.size();
 }
 
 std::pair<std::vector<int>, std::map<int,int>> MDS_CONTEXT::get_undetermined_vertices() {
-	std::vector<int>undetermined;
-	int total_vertices = get_total_vertices();
-	int index = 0;
+	std::vector<int>undetermined = undetermined_set.sorted();
 	std::map<int, int> translation_pace_to_ilp;
 	//std::map<int, int> translation_ilp_to_pace; TODO later
-	for (int i = 0; i < total_vertices; ++i) {
-		if (!excluded[i] && !removed[i] && !selected[i]) {
-			translation_pace_to_ilp[i] = index;
-			undetermined.push_back(i);
-			index++;
-		}
+	for (int index = 0; index < static_cast<int>(undetermined.size()); ++index) {
+		translation_pace_to_ilp.emplace_hint(translation_pace_to_ilp.end(), undetermined[index], index);
 	}
 	return (std::make_pair(undetermined, translation_pace_to_ilp));
 }
 
 vertex MDS_CONTEXT::get_source_edge(edge e) {
-	return(boost::source(e, graph));
+	return(graph.endpoints(e).source);
 }
 
 vertex MDS_CONTEXT::get_target_edge(edge e) {
-	return(boost::target(e, graph));
+	return(graph.endpoints(e).target);
 }
 
 vertex MDS_CONTEXT::add_vertex(){
-	vertex new_vertex = boost::add_vertex(graph);
+	vertex new_vertex = graph.add_vertex();
 	//assumption new vertex id is just 1 higher.
-	selected.push_back(false);
-	dominated.push_back(false);
-	removed.push_back(false);
-	excluded.push_back(false);
-	ignored.push_back(false);
-	c_d.push_back(0);
-	c_nd.push_back(0);
-	c_x.push_back(0);
+	state.push_back(0);
+	counters.push_back(vertex_counters{ 0, 0, 0 });
+	undetermined_set.grow(true);
+	undominated_set.grow(true);
+	not_removed_set.grow(true);
+	record_change(new_vertex);
 
 	num_nodes++;
 	return new_vertex;
 }
 
-void MDS_CONTEXT::fill_mds_context(MDS_CONTEXT& mds_context, std::unordered_map<int, int>& newToOldIndex) {
+void MDS_CONTEXT::fill_mds_context(MDS_CONTEXT& mds_context, const std::vector<int>& newToOldIndex) {
 	int num_vertices = get_total_vertices();
 	for (int i = 0; i < num_vertices; ++i) {
 		int OldIndex = newToOldIndex[i];
 		if (mds_context.is_dominated(OldIndex)) {
-			dominated[i] = true;
+			set_state(i, STATE_DOMINATED);
 		}
 		if (mds_context.is_excluded(OldIndex)) {
-			excluded[i] = true;
+			set_state(i, STATE_EXCLUDED);
 		}
 		if (mds_context.is_ignored(OldIndex)) {
-			ignored[i] = true;
+			set_state(i, STATE_IGNORED);
 		}
 	}
 }
 
+void MDS_CONTEXT::release_graph() {
+	graph = DYNAMIC_GRAPH();
+}
 
+std::size_t MDS_CONTEXT::memory_bytes() const {
+	return graph.memory_bytes() + state.capacity() * sizeof(std::uint8_t) + counters.capacity() * sizeof(vertex_counters);
+}
+
+bool MDS_CONTEXT::has_state(vertex v, std::uint8_t flags) {
+	return state[v] & flags;
+}
 
+void MDS_CONTEXT::set_state(vertex v, std::uint8_t flags) {
+	const std::uint8_t old_state = state[v];
+	const std::uint8_t new_state = old_state | flags;
+	if (new_state == old_state) {
+		return;
+	}
+	state[v] = new_state;
+	record_change(v);
+	if (new_state & (STATE_SELECTED | STATE_EXCLUDED | STATE_REMOVED)) {
+		undetermined_set.erase(v);
+	}
+	if (new_state & (STATE_DOMINATED | STATE_IGNORED)) {
+		undominated_set.erase(v);
+	}
+	if (new_state & STATE_REMOVED) {
+		not_removed_set.erase(v);
+	}
+	const std::uint8_t dominated_excluded = STATE_DOMINATED | STATE_EXCLUDED;
+	if ((new_state & dominated_excluded) == dominated_excluded && (old_state & dominated_excluded) != dominated_excluded) {
+		cnt_dominated_excluded++;
+	}
+}
+
+//SWAR helpers, a word holds the state of 8 consecutive vertices (little endian: vertex i is byte i).
+static const std::uint64_t BYTES_LOW_7 = 0x7f7f7f7f7f7f7f7fULL;
+static const std::uint64_t BYTES_HIGH = 0x8080808080808080ULL;
+
+static inline std::uint64_t broadcast_byte(std::uint8_t b) {
+	return 0x0101010101010101ULL * b;
+}
+
+//the high bit of every byte in the result is set iff (byte & mask) == value.
+static inline std::uint64_t match_bytes(std::uint64_t word, std::uint64_t mask, std::uint64_t value) {
+	std::uint64_t x = (word & mask) ^ value;
+	//high bit of a byte is set iff the byte is not zero, without carries between bytes.
+	std::uint64_t nonzero = (((x & BYTES_LOW_7) + BYTES_LOW_7) | x) & BYTES_HIGH;
+	return nonzero ^ BYTES_HIGH;
+}
+
+static inline std::uint64_t load_word(const std::uint8_t* p) {
+	std::uint64_t word;
+	std::memcpy(&word, p, sizeof(word));
+	return word;
+}
+
+int MDS_CONTEXT::count_state(std::uint8_t mask, std::uint8_t value, int begin, int end) {
+	const std::uint64_t m = broadcast_byte(mask), val = broadcast_byte(value);
+	const std::uint8_t* data = state.data();
+	int cnt = 0;
+	int v = begin;
+	for (; v + 8 <= end; v += 8) {
+		cnt += __builtin_popcountll(match_bytes(load_word(data + v), m, val));
+	}
+	for (; v < end; ++v) {
+		cnt += ((data[v] & mask) == value);
+	}
+	return cnt;
+}
+
+int MDS_CONTEXT::find_next_state(std::uint8_t mask, std::uint8_t value, int begin, int end) {
+	const std::uint64_t m = broadcast_byte(mask), val = broadcast_byte(value);
+	const std::uint8_t* data = state.data();
+	int v = begin;
+	for (; v + 8 <= end; v += 8) {
+		std::uint64_t match = match_bytes(load_word(data + v), m, val);
+		if (match) {
+			return v + (__builtin_ctzll(match) >> 3);
+		}
+	}
+	for (; v < end; ++v) {
+		if ((data[v] & mask) == value) {
+			return v;
+		}
+	}
+	return end;
+}
+
+void MDS_CONTEXT::collect_state(std::uint8_t mask, std::uint8_t value, int begin, int end, std::vector<int>& vertices) {
+	const std::uint64_t m = broadcast_byte(mask), val = broadcast_byte(value);
+	const std::uint8_t* data = state.data();
+	int v = begin;
+	for (; v + 8 <= end; v += 8) {
+		std::uint64_t match = match_bytes(load_word(data + v), m, val);
+		while (match) {
+			vertices.push_back(v + (__builtin_ctzll(match) >> 3));
+			match &= match - 1;
+		}
+	}
+	for (; v < end; ++v) {
+		if ((data[v] & mask) == value) {
+			vertices.push_back(v);
+		}
+	}
+}
+
+int MDS_CONTEXT::set_state_where(std::uint8_t mask, std::uint8_t value, std::uint8_t flags) {
+	std::vector<int> vertices;
+	collect_state(mask, value, 0, state.size(), vertices);
+	//through set_state, so the indexes stay up to date.
+	for (int v : vertices) {
+		set_state(v, flags);
+	}
+	return vertices.size();
+}
+
+std::vector<bool> MDS_CONTEXT::get_state_vector(std::uint8_t flag) {
+	std::vector<bool> flags(state.size());
+	for (std::size_t v = 0; v < state.size(); ++v) {
+		flags[v] = state[v] & flag;
+	}
+	return flags;
+}
+
+void MDS_CONTEXT::subscribe_changes(std::vector<int>* log, EPOCH_MARKER* logged) {
+	change_logs.emplace_back(log, logged);
+	tracking = true;
+}
+
+void MDS_CONTEXT::unsubscribe_changes(std::vector<int>* log) {
+	change_logs.erase(std::remove_if(change_logs.begin(), change_logs.end(), [log](const auto& entry) { return entry.first == log; }), change_logs.end());
+	tracking = !change_logs.empty();
+}
+
+void MDS_CONTEXT::record_change(vertex v) {
+	if (tracking) {
+		for (auto [log, logged] : change_logs) {
+			if (logged != nullptr && v < static_cast<vertex>(logged->size())) {
+				if (logged->contains(v)) {
+					continue;
+				}
+				logged->insert(v);
+			}
+			log->push_back(v);
+		}
+	}
+}
@@ -2,6 +2,13 @@
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/boyer_myrvold_planar_test.hpp>
 
+#include <cstdint>
+
+#include "dynamic_graph.h"
+#include "subgraph_view.h"
+#include "../util/sparse_set.h"
+#include "../util/epoch_marker.h"
+
 typedef boost::adjacency_list<
     boost::vecS,                                  // Param:OutEdgeList (cointainer used for edge-list (vector))
     boost::vecS,                                  // Param:VertexList (cointainer used for vectexList (vector))
@@ -12,25 +19,42 @@ typedef boost::adjacency_list<
 
 
 typedef boost::graph_traits<adjacencyListBoost>::vertex_descriptor vertex;
-typedef boost::graph_traits<adjacencyListBoost>::edge_descriptor edge;
-typedef boost::graph_traits<adjacencyListBoost>::adjacency_iterator adjacency_itt;
+typedef int edge; // edge id in the DYNAMIC_GRAPH of the context.
+typedef DYNAMIC_GRAPH::neighbor_iterator adjacency_itt;
 typedef boost::graph_traits<adjacencyListBoost>::vertex_iterator vertex_itt;
 typedef boost::graph_traits<adjacencyListBoost>::edge_iterator edge_itt;
+typedef DYNAMIC_GRAPH::edge_iterator context_edge_itt;
+
+//state of a vertex, all flags of a vertex are packed in one byte.
+enum vertex_state_flag : std::uint8_t {
+    STATE_SELECTED = 1,
+    STATE_DOMINATED = 2,
+    STATE_REMOVED = 4,
+    STATE_EXCLUDED = 8,
+    STATE_IGNORED = 16
+};
+
+//the counters of a vertex are stored next to each other, a rule reads them with one cache line.
+struct vertex_counters {
+    int c_d;
+    int c_nd;   // number of dominated (or ignored) vertices in N[v].
+    int c_x;    // number of excluded vertices in N[v].
+};
 
 class MDS_CONTEXT {
 public:
     int num_nodes;
-    adjacencyListBoost graph;
+    DYNAMIC_GRAPH graph; // edges are removed lazily, see DYNAMIC_GRAPH.
 
-    std::vector<bool> selected;
-    std::vector<bool> dominated;
-    std::vector<bool> removed;
-    std::vector<bool> excluded;
-    std::vector<bool> ignored;
+    std::vector<std::uint8_t> state;        // vertex_state_flag bits per vertex.
+    std::vector<vertex_counters> counters;
 
-    std::vector<int> c_d;
-    std::vector<int> c_nd;
-    std::vector<int> c_x;
+    //indexes of the vertices which are still live, maintained by set_state. flags are never cleared, so vertices only leave them.
+    //sorted() gives a snapshot to sweep over (in ascending order) while the state changes.
+    SPARSE_SET undetermined_set;    // not selected, excluded or removed.
+    SPARSE_SET undominated_set;     // not dominated and not ignored.
+    SPARSE_SET not_removed_set;
+    int cnt_dominated_excluded;     // dominated and excluded vertices (removed or not).
 
     int cnt_sel;   // Size of the current solution.
     int cnt_dom;   // Number of dominated vertices.
@@ -41,7 +65,20 @@ public:
     // Constructor
     MDS_CONTEXT(adjacencyListBoost& g);
 
-    adjacencyListBoost& get_graph();
+    //context of a (component) view, the vertices are the local vertices of the view.
+    explicit MDS_CONTEXT(const SUBGRAPH_VIEW& view);
+
+    //context of a component of g without building the component graph: vertices are the vertices of the component (ascending),
+    //local_index[v] is the vertex of v in the context.
+    MDS_CONTEXT(const CSR_GRAPH& g, const std::vector<int>& vertices, const std::vector<int>& local_index);
+
+    //a context owns a copy of the graph, it is moved between the stages and never copied.
+    MDS_CONTEXT(const MDS_CONTEXT&) = delete;
+    MDS_CONTEXT& operator=(const MDS_CONTEXT&) = delete;
+    MDS_CONTEXT(MDS_CONTEXT&&) = default;
+    MDS_CONTEXT& operator=(MDS_CONTEXT&&) = default;
+
+    DYNAMIC_GRAPH& get_graph();
 
     std::pair<vertex_itt, vertex_itt> get_vertices_itt();
 
@@ -55,7 +92,7 @@ public:
 
     int get_coverage_size(vertex v);
 
-    std::pair<edge_itt, edge_itt> get_edge_itt();
+    std::pair<context_edge_itt, context_edge_itt> get_edge_itt();
 
     vertex get_source_edge(edge e);
 
@@ -67,11 +104,20 @@ public:
 
     void remove_vertex(vertex v);
 
-    void fill_mds_context(MDS_CONTEXT& mds_context, std::unordered_map<int, int>& newToOldIndex);
+    //removes all edges of v.
+    void clear_vertex(vertex v);
 
-    void get_lookup_l_neighborhood(std::vector<int>& l_vertices, std::unordered_set<int>& lookup_neighbourhood);
+    //copies the state from mds_context, newToOldIndex[v] is the vertex of mds_context for v (e.g. SUBGRAPH_VIEW::local_to_global()).
+    void fill_mds_context(MDS_CONTEXT& mds_context, const std::vector<int>& newToOldIndex);
 
-    void get_l_neighborhood(std::vector<int>& l_vertices, std::unordered_set<int>& lookup_neighbourhood, std::vector<int>& l_neighbourhood);
+    //frees the graph once the reduced graph is extracted, the state stays (fill_mds_context only reads the state).
+    void release_graph();
+
+    //heap memory of the graph and the vertex state, for the memory statistics.
+    std::size_t memory_bytes() const;
+
+    //lookup_neighbourhood is cleared and gets N[l_vertices], l_neighbourhood the neighbors which are still relevant.
+    void get_l_neighborhood(std::vector<int>& l_vertices, EPOCH_MARKER& lookup_neighbourhood, std::vector<int>& l_neighbourhood);
 
     void fill_removed_vertex();
 
@@ -95,7 +141,8 @@ public:
 
     std::pair<adjacency_itt, adjacency_itt> get_neighborhood_itt(vertex v);
 
-    std::pair<std::vector<int>, std::vector<vertex>> get_pair_neighborhood(vertex v, vertex w);
+    //neighbors of v and w (without v and w), lookup is cleared and gets N[v] and N[w].
+    std::vector<vertex> get_pair_neighborhood(vertex v, vertex w, EPOCH_MARKER& lookup);
 
     std::vector<vertex> get_undominated_vector(std::vector<vertex>& vertices);
 
@@ -105,6 +152,9 @@ public:
 
     void remove_edge(vertex v, vertex w);
 
+    //removes the edge to the neighbor itt points at (itt iterates the neighborhood of v), safe while iterating.
+    void remove_edge(vertex v, const adjacency_itt& itt);
+
     bool is_excluded(vertex v);
 
     void add_edge(vertex v, vertex w);
@@ -116,4 +166,42 @@ public:
     int get_frequency(vertex v);
 
     bool is_ignored(vertex v);
+
+    //true if v has one of the flags.
+    bool has_state(vertex v, std::uint8_t flags);
+
+    //sets the flags without updating the counters, every state change goes through here to keep the indexes up to date.
+    void set_state(vertex v, std::uint8_t flags);
+
+    //bulk accessors, they test 8 vertices per 64 bit word.
+    //number of vertices in [begin, end) with (state & mask) == value.
+    int count_state(std::uint8_t mask, std::uint8_t value, int begin, int end);
+
+    //first vertex >= begin and < end with (state & mask) == value, end if there is none.
+    int find_next_state(std::uint8_t mask, std::uint8_t value, int begin, int end);
+
+    //appends all vertices in [begin, end) with (state & mask) == value.
+    void collect_state(std::uint8_t mask, std::uint8_t value, int begin, int end, std::vector<int>& vertices);
+
+    //sets flags on all vertices with (state & mask) == value, returns the number of these vertices.
+    int set_state_where(std::uint8_t mask, std::uint8_t value, std::uint8_t flags);
+
+    //one flag as a vector (indexed by vertex), for the solvers which take the state as vector<bool>.
+    std::vector<bool> get_state_vector(std::uint8_t flag);
+
+    //every vertex whose state, counters or edges change is appended to log (with duplicates) until it is unsubscribed.
+    //with logged a vertex is only appended if it is not in logged yet (and inserted), vertices beyond logged->size() always.
+    //the consumer (the WORKLIST or the CANDIDATE_PAIRS of the rules) reads and clears its log (and logged) itself.
+    void subscribe_changes(std::vector<int>* log, EPOCH_MARKER* logged = nullptr);
+
+    void unsubscribe_changes(std::vector<int>* log);
+
+private:
+    bool tracking;
+    std::vector<std::pair<std::vector<int>*, EPOCH_MARKER*>> change_logs;
+
+    void record_change(vertex v);
+
+    //state of num_nodes undetermined vertices, after the graph is built.
+    void initialize_state();
 };
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "csr_graph.h"
+
+#include <algorithm>
+
+#include "../util/mapped_file.h"
+
+CSR_GRAPH::CSR_GRAPH() : num_vertices(0), num_edges(0), offsets(1, 0), mapped_offsets(nullptr), mapped_neighbors(nullptr) {}
+
+CSR_GRAPH::CSR_GRAPH(int n, long long m, std::vector<std::uint64_t> offsets, std::vector<std::uint32_t> neighbors)
+    : num_vertices(n), num_edges(m), offsets(std::move(offsets)), neighbors(std::move(neighbors)), mapped_offsets(nullptr), mapped_neighbors(nullptr) {}
+
+CSR_GRAPH::CSR_GRAPH(int n, long long m, std::shared_ptr<const MAPPED_FILE> mapping, const std::uint64_t* mapped_offsets, const std::uint32_t* mapped_neighbors)
+    : num_vertices(n), num_edges(m), mapping(std::move(mapping)), mapped_offsets(mapped_offsets), mapped_neighbors(mapped_neighbors) {}
+
+const std::uint64_t* CSR_GRAPH::offset_data() const {
+    return mapping ? mapped_offsets : offsets.data();
+}
+
+const std::uint32_t* CSR_GRAPH::neighbor_data() const {
+    return mapping ? mapped_neighbors : neighbors.data();
+}
+
+std::uint64_t CSR_GRAPH::num_neighbors() const {
+    return offset_data()[num_vertices];
+}
+
+int CSR_GRAPH::get_degree(int v) const {
+    const std::uint64_t* offset = offset_data();
+    return static_cast<int>(offset[v + 1] - offset[v]);
+}
+
+std::pair<const std::uint32_t*, const std::uint32_t*> CSR_GRAPH::get_neighborhood(int v) const {
+    const std::uint64_t* offset = offset_data();
+    const std::uint32_t* base = neighbor_data();
+    return std::make_pair(base + offset[v], base + offset[v + 1]);
+}
+
+long long CSR_GRAPH::find_edge(int u, int v) const {
+    auto [neigh_itt, neigh_itt_end] = get_neighborhood(u);
+    const std::uint32_t* it = std::lower_bound(neigh_itt, neigh_itt_end, static_cast<std::uint32_t>(v));
+    if (it == neigh_itt_end || *it != static_cast<std::uint32_t>(v)) {
+        return -1;
+    }
+    return it - neighbor_data();
+}
+
+bool CSR_GRAPH::edge_exists(int u, int v) const {
+    return find_edge(u, v) != -1;
+}
+
+int CSR_GRAPH::connected_components(std::vector<int>& component_map) const {
+    component_map.assign(num_vertices, -1);
+    std::vector<std::uint32_t> stack;
+    int num_components = 0;
+    for (int s = 0; s < num_vertices; ++s) {
+        if (component_map[s] != -1) {
+            continue;
+        }
+        component_map[s] = num_components;
+        stack.push_back(s);
+        while (!stack.empty()) {
+            const std::uint32_t u = stack.back();
+            stack.pop_back();
+            auto [neigh_itt, neigh_itt_end] = get_neighborhood(u);
+            for (; neigh_itt != neigh_itt_end; ++neigh_itt) {
+                if (component_map[*neigh_itt] == -1) {
+                    component_map[*neigh_itt] = num_components;
+                    stack.push_back(*neigh_itt);
+                }
+            }
+        }
+        num_components++;
+    }
+    return num_components;
+}
+
+//find_edge (used by the nice tree decomposition to mark introduced edges) and remove_duplicate_edges expect sorted neighborhoods.
+//writing u into the neighborhood of each of its neighbors, for increasing u, is a counting sort on the target
+//after the counting sort on the source the parser already did (an LSD radix sort with vertex ids as digits).
+void CSR_GRAPH::sort_neighborhoods() {
+    own();
+    std::vector<std::uint32_t> sorted(neighbors.size());
+    std::vector<std::uint64_t> position(offsets.begin(), offsets.end() - 1);
+    for (int u = 0; u < num_vertices; ++u) {
+        for (std::uint64_t i = offsets[u]; i < offsets[u + 1]; ++i) {
+            sorted[position[neighbors[i]]++] = static_cast<std::uint32_t>(u);
+        }
+    }
+    neighbors.swap(sorted);
+}
+
+void CSR_GRAPH::remove_duplicate_edges(long long& duplicates, long long& self_loops) {
+    own();
+    duplicates = 0;
+    self_loops = 0;
+    std::uint64_t write = 0;
+    std::uint64_t begin = offsets[0];
+    for (int v = 0; v < num_vertices; ++v) {
+        const std::uint64_t end = offsets[v + 1];
+        offsets[v] = write;
+        for (std::uint64_t i = begin; i < end; ++i) {
+            const std::uint32_t w = neighbors[i];
+            //a self loop is stored once, a parallel edge at both endpoints (counted at the smaller one).
+            if (w == static_cast<std::uint32_t>(v)) {
+                self_loops++;
+                continue;
+            }
+            if (write > offsets[v] && neighbors[write - 1] == w) {
+                if (w > static_cast<std::uint32_t>(v)) {
+                    duplicates++;
+                }
+                continue;
+            }
+            neighbors[write++] = w;
+        }
+        begin = end;
+    }
+    offsets[num_vertices] = write;
+    neighbors.resize(write);
+    neighbors.shrink_to_fit();
+    num_edges = static_cast<long long>(write / 2);
+}
+
+void CSR_GRAPH::own() {
+    if (!mapping) {
+        return;
+    }
+    offsets.assign(mapped_offsets, mapped_offsets + num_vertices + 1);
+    neighbors.assign(mapped_neighbors, mapped_neighbors + mapped_offsets[num_vertices]);
+    mapping.reset();
+    mapped_offsets = nullptr;
+    mapped_neighbors = nullptr;
+}
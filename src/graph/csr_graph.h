@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class MAPPED_FILE;
+
+//Compressed sparse row graph (undirected, every edge is stored in the neighborhood of both endpoints).
+class CSR_GRAPH {
+public:
+    int num_vertices;
+    long long num_edges;
+
+    std::vector<std::uint64_t> offsets; // neighbors of v are neighbors[offsets[v]] ... neighbors[offsets[v+1]-1].
+    std::vector<std::uint32_t> neighbors;
+
+    //set if the arrays are borrowed from a mapped .grb cache, offsets and neighbors are empty then.
+    //every copy of the graph keeps the mapping alive.
+    std::shared_ptr<const MAPPED_FILE> mapping;
+
+    CSR_GRAPH();
+
+    CSR_GRAPH(int n, long long m, std::vector<std::uint64_t> offsets, std::vector<std::uint32_t> neighbors);
+
+    //borrows the arrays, mapped_offsets and mapped_neighbors point into mapping.
+    CSR_GRAPH(int n, long long m, std::shared_ptr<const MAPPED_FILE> mapping, const std::uint64_t* mapped_offsets, const std::uint32_t* mapped_neighbors);
+
+    //owned or borrowed arrays, use these instead of offsets and neighbors when reading.
+    const std::uint64_t* offset_data() const;
+
+    const std::uint32_t* neighbor_data() const;
+
+    std::uint64_t num_neighbors() const;
+
+    int get_degree(int v) const;
+
+    std::pair<const std::uint32_t*, const std::uint32_t*> get_neighborhood(int v) const;
+
+    //position of v in the (sorted) neighborhood of u in neighbors, -1 if there is no edge.
+    long long find_edge(int u, int v) const;
+
+    bool edge_exists(int u, int v) const;
+
+    //component_map[v] is the component of v, numbered in order of their smallest vertex (as boost::connected_components).
+    int connected_components(std::vector<int>& component_map) const;
+
+    //the graph has to be symmetric (every edge stored at both endpoints), it is transposed in O(n + m).
+    void sort_neighborhoods();
+
+    //neighborhoods have to be sorted. removes self loops and parallel edges, and returns how many (undirected) edges were dropped.
+    void remove_duplicate_edges(long long& duplicates, long long& self_loops);
+
+private:
+    const std::uint64_t* mapped_offsets;
+    const std::uint32_t* mapped_neighbors;
+
+    //copies borrowed arrays into offsets and neighbors, before they are changed.
+    void own();
+};
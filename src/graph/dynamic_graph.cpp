@@ -0,0 +1,343 @@
+#include "dynamic_graph.h"
+
+#include <algorithm>
+
+//a bitmap row has num_vertices bits, it is only created if that is at most 8 bytes per neighbor.
+static const int BITMAP_MIN_DEGREE = 64;
+//dense mode keeps a n x n bit matrix (2 MB at this size), for graphs with an average degree of at least n / 64.
+static const int DENSE_MAX_VERTICES = 4096;
+
+//the pair table starts with this many slots (a power of two).
+static const int MIN_PAIR_SLOTS_LOG = 4;
+
+DYNAMIC_GRAPH::DYNAMIC_GRAPH() : num_live_edges(0), pair_slots(std::size_t(1) << MIN_PAIR_SLOTS_LOG, EDGE_NONE), pair_shift(64 - MIN_PAIR_SLOTS_LOG), num_pairs(0), dense(false) {}
+
+DYNAMIC_GRAPH::DYNAMIC_GRAPH(int n) : adjacency(n), live_degree(n, 0), num_live_edges(0), fingerprint(n, 0),
+    pair_slots(std::size_t(1) << MIN_PAIR_SLOTS_LOG, EDGE_NONE), pair_shift(64 - MIN_PAIR_SLOTS_LOG), num_pairs(0), bitmap_row(n, -1), dense(false) {}
+
+int DYNAMIC_GRAPH::num_vertices() const {
+    return static_cast<int>(adjacency.size());
+}
+
+int DYNAMIC_GRAPH::num_edges() const {
+    return num_live_edges;
+}
+
+int DYNAMIC_GRAPH::degree(int v) const {
+    return live_degree[v];
+}
+
+std::pair<DYNAMIC_GRAPH::neighbor_iterator, DYNAMIC_GRAPH::neighbor_iterator> DYNAMIC_GRAPH::neighbors(int v) const {
+    const adjacency_entry* begin = adjacency[v].data();
+    const adjacency_entry* end = begin + adjacency[v].size();
+    return std::make_pair(neighbor_iterator(begin, end, &alive), neighbor_iterator(end, end, &alive));
+}
+
+std::pair<DYNAMIC_GRAPH::edge_iterator, DYNAMIC_GRAPH::edge_iterator> DYNAMIC_GRAPH::edges() const {
+    const int end = static_cast<int>(edge_list.size());
+    return std::make_pair(edge_iterator(0, end, &alive), edge_iterator(end, end, &alive));
+}
+
+DYNAMIC_GRAPH::edge_endpoints DYNAMIC_GRAPH::endpoints(int edge_id) const {
+    return edge_list[edge_id];
+}
+
+int DYNAMIC_GRAPH::add_vertex() {
+    adjacency.emplace_back();
+    live_degree.push_back(0);
+    fingerprint.push_back(0);
+    bitmap_row.push_back(-1);
+    if (dense) {
+        //the matrix stays square.
+        for (auto& row : bitmap_rows) {
+            row.resize(adjacency.size());
+        }
+        maybe_add_bitmap_row(static_cast<int>(adjacency.size()) - 1);
+    }
+    return static_cast<int>(adjacency.size()) - 1;
+}
+
+int DYNAMIC_GRAPH::add_edge(int v, int w) {
+    const std::uint32_t edge_id = static_cast<std::uint32_t>(edge_list.size());
+    edge_list.push_back({ static_cast<std::uint32_t>(v), static_cast<std::uint32_t>(w) });
+    alive.push_back(true);
+    next_parallel.push_back(EDGE_NONE);
+    adjacency[v].push_back({ static_cast<std::uint32_t>(w), edge_id });
+    live_degree[v]++;
+    fingerprint[v] |= fingerprint_bit(w);
+    //a self loop is stored once.
+    if (v != w) {
+        adjacency[w].push_back({ static_cast<std::uint32_t>(v), edge_id });
+        live_degree[w]++;
+        fingerprint[w] |= fingerprint_bit(v);
+    }
+    num_live_edges++;
+    const std::size_t slot = find_pair(v, w);
+    if (pair_slots[slot] == EDGE_NONE) {
+        pair_slots[slot] = edge_id;
+        num_pairs++;
+        set_bitmap_bit(v, w, true);
+        if (2 * num_pairs > pair_slots.size()) {
+            rebuild_pairs(2 * pair_slots.size());
+        }
+    } else {
+        //parallel edge, it becomes the first of the list.
+        next_parallel[edge_id] = pair_slots[slot];
+        pair_slots[slot] = edge_id;
+    }
+    maybe_add_bitmap_row(v);
+    maybe_add_bitmap_row(w);
+    return static_cast<int>(edge_id);
+}
+
+std::uint64_t DYNAMIC_GRAPH::edge_key(int v, int w) {
+    const std::uint64_t low = static_cast<std::uint32_t>(std::min(v, w));
+    const std::uint64_t high = static_cast<std::uint32_t>(std::max(v, w));
+    return (low << 32) | high;
+}
+
+std::size_t DYNAMIC_GRAPH::home_slot(std::uint64_t key) const {
+    return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ULL) >> pair_shift);
+}
+
+std::size_t DYNAMIC_GRAPH::find_pair(int v, int w) const {
+    const std::uint64_t key = edge_key(v, w);
+    const std::size_t mask = pair_slots.size() - 1;
+    std::size_t slot = home_slot(key);
+    while (pair_slots[slot] != EDGE_NONE) {
+        const edge_endpoints& e = edge_list[pair_slots[slot]];
+        if (edge_key(e.source, e.target) == key) {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void DYNAMIC_GRAPH::erase_pair(std::size_t slot) {
+    const std::size_t mask = pair_slots.size() - 1;
+    std::size_t hole = slot;
+    for (std::size_t next = (slot + 1) & mask; pair_slots[next] != EDGE_NONE; next = (next + 1) & mask) {
+        const edge_endpoints& e = edge_list[pair_slots[next]];
+        const std::size_t home = home_slot(edge_key(e.source, e.target));
+        //the entry may move to the hole if the hole is not before its home slot (cyclically).
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            pair_slots[hole] = pair_slots[next];
+            hole = next;
+        }
+    }
+    pair_slots[hole] = EDGE_NONE;
+    num_pairs--;
+}
+
+void DYNAMIC_GRAPH::rebuild_pairs(std::size_t num_slots) {
+    int slots_log = MIN_PAIR_SLOTS_LOG;
+    while ((std::size_t(1) << slots_log) < num_slots) {
+        slots_log++;
+    }
+    pair_slots.assign(std::size_t(1) << slots_log, EDGE_NONE);
+    pair_shift = 64 - slots_log;
+    num_pairs = 0;
+    //the first live edge of a pair goes into the table, the later ones are appended to its list.
+    std::vector<std::uint32_t> last(edge_list.size(), EDGE_NONE);
+    for (std::size_t e = 0; e < edge_list.size(); ++e) {
+        if (!alive[e]) {
+            continue;
+        }
+        const std::size_t slot = find_pair(edge_list[e].source, edge_list[e].target);
+        next_parallel[e] = EDGE_NONE;
+        if (pair_slots[slot] == EDGE_NONE) {
+            pair_slots[slot] = static_cast<std::uint32_t>(e);
+            last[e] = static_cast<std::uint32_t>(e);
+            num_pairs++;
+        } else {
+            const std::uint32_t first = pair_slots[slot];
+            next_parallel[last[first]] = static_cast<std::uint32_t>(e);
+            last[first] = static_cast<std::uint32_t>(e);
+        }
+    }
+}
+
+void DYNAMIC_GRAPH::set_bitmap_bit(int v, int w, bool value) {
+    if (bitmap_row[v] >= 0) {
+        boost::dynamic_bitset<>& row = bitmap_rows[bitmap_row[v]];
+        if (w >= static_cast<int>(row.size())) {
+            row.resize(adjacency.size());
+        }
+        row[w] = value;
+    }
+    if (v != w && bitmap_row[w] >= 0) {
+        boost::dynamic_bitset<>& row = bitmap_rows[bitmap_row[w]];
+        if (v >= static_cast<int>(row.size())) {
+            row.resize(adjacency.size());
+        }
+        row[v] = value;
+    }
+}
+
+void DYNAMIC_GRAPH::maybe_add_bitmap_row(int v) {
+    if (bitmap_row[v] >= 0) {
+        return;
+    }
+    if (!dense && (live_degree[v] < BITMAP_MIN_DEGREE || 64LL * live_degree[v] < static_cast<long long>(adjacency.size()))) {
+        return;
+    }
+    boost::dynamic_bitset<> row(adjacency.size());
+    for (const adjacency_entry& entry : adjacency[v]) {
+        if (alive[entry.edge_id]) {
+            row[entry.target] = true;
+        }
+    }
+    bitmap_row[v] = static_cast<int>(bitmap_rows.size());
+    bitmap_rows.push_back(std::move(row));
+}
+
+bool DYNAMIC_GRAPH::edge_exists(int v, int w) const {
+    //bitmap fast path, no hashing for the high degree vertices.
+    if (bitmap_row[v] >= 0) {
+        const boost::dynamic_bitset<>& row = bitmap_rows[bitmap_row[v]];
+        return w < static_cast<int>(row.size()) && row[w];
+    }
+    if (bitmap_row[w] >= 0) {
+        const boost::dynamic_bitset<>& row = bitmap_rows[bitmap_row[w]];
+        return v < static_cast<int>(row.size()) && row[v];
+    }
+    return pair_slots[find_pair(v, w)] != EDGE_NONE;
+}
+
+void DYNAMIC_GRAPH::kill_edge(std::uint32_t edge_id) {
+    alive[edge_id] = false;
+    const edge_endpoints& e = edge_list[edge_id];
+    live_degree[e.source]--;
+    if (e.source != e.target) {
+        live_degree[e.target]--;
+    }
+    num_live_edges--;
+    const std::size_t slot = find_pair(e.source, e.target);
+    if (pair_slots[slot] == edge_id) {
+        if (next_parallel[edge_id] == EDGE_NONE) {
+            erase_pair(slot);
+            set_bitmap_bit(e.source, e.target, false);
+        } else {
+            pair_slots[slot] = next_parallel[edge_id];
+        }
+        return;
+    }
+    //a parallel edge, unlinked from the list of its pair.
+    std::uint32_t previous = pair_slots[slot];
+    while (next_parallel[previous] != edge_id) {
+        previous = next_parallel[previous];
+    }
+    next_parallel[previous] = next_parallel[edge_id];
+}
+
+void DYNAMIC_GRAPH::remove_edge(int v, int w) {
+    //the first edge of the list is killed each time, the pair is dropped with the last one.
+    std::uint32_t edge_id = pair_slots[find_pair(v, w)];
+    while (edge_id != EDGE_NONE) {
+        const std::uint32_t next = next_parallel[edge_id];
+        kill_edge(edge_id);
+        edge_id = next;
+    }
+}
+
+void DYNAMIC_GRAPH::remove_edge(const neighbor_iterator& itt) {
+    if (alive[itt.entry()->edge_id]) {
+        kill_edge(itt.entry()->edge_id);
+    }
+}
+
+void DYNAMIC_GRAPH::clear_vertex(int v) {
+    //the entries stay in place (dead), an iterator over this neighborhood is still valid.
+    for (const adjacency_entry& entry : adjacency[v]) {
+        if (alive[entry.edge_id]) {
+            kill_edge(entry.edge_id);
+        }
+    }
+    fingerprint[v] = 0;
+}
+
+void DYNAMIC_GRAPH::compact() {
+    std::vector<std::uint32_t> new_id(edge_list.size());
+    std::vector<edge_endpoints> live_edges;
+    live_edges.reserve(num_live_edges);
+    for (std::size_t e = 0; e < edge_list.size(); ++e) {
+        if (alive[e]) {
+            new_id[e] = static_cast<std::uint32_t>(live_edges.size());
+            live_edges.push_back(edge_list[e]);
+        }
+    }
+    for (std::size_t v = 0; v < adjacency.size(); ++v) {
+        std::vector<adjacency_entry>& neighborhood = adjacency[v];
+        std::size_t write = 0;
+        //the fingerprint is exact again afterwards.
+        fingerprint[v] = 0;
+        for (const adjacency_entry& entry : neighborhood) {
+            if (alive[entry.edge_id]) {
+                neighborhood[write++] = { entry.target, new_id[entry.edge_id] };
+                fingerprint[v] |= fingerprint_bit(entry.target);
+            }
+        }
+        neighborhood.resize(write);
+    }
+    edge_list = std::move(live_edges);
+    alive.assign(edge_list.size(), true);
+    //the table holds edge ids, it is built again for the new ids (and shrinks with the graph).
+    next_parallel.assign(edge_list.size(), EDGE_NONE);
+    rebuild_pairs(4 * num_pairs);
+}
+
+void DYNAMIC_GRAPH::maybe_compact() {
+    const std::size_t dead = edge_list.size() - num_live_edges;
+    if (dead > 1024 && 2 * dead > edge_list.size()) {
+        compact();
+    }
+}
+
+std::size_t DYNAMIC_GRAPH::memory_bytes() const {
+    std::size_t bytes = adjacency.capacity() * sizeof(std::vector<adjacency_entry>);
+    for (const auto& neighborhood : adjacency) {
+        bytes += neighborhood.capacity() * sizeof(adjacency_entry);
+    }
+    bytes += edge_list.capacity() * sizeof(edge_endpoints);
+    bytes += alive.capacity() / 8 + next_parallel.capacity() * sizeof(std::uint32_t);
+    bytes += live_degree.capacity() * sizeof(int) + bitmap_row.capacity() * sizeof(int);
+    bytes += fingerprint.capacity() * sizeof(std::uint64_t);
+    bytes += pair_slots.capacity() * sizeof(std::uint32_t);
+    for (const auto& row : bitmap_rows) {
+        bytes += row.num_blocks() * sizeof(boost::dynamic_bitset<>::block_type);
+    }
+    return bytes;
+}
+
+void DYNAMIC_GRAPH::maybe_make_dense() {
+    const long long n = adjacency.size();
+    if (dense || n == 0 || n > DENSE_MAX_VERTICES || 64LL * 2 * num_live_edges < n * n) {
+        return;
+    }
+    dense = true;
+    for (int v = 0; v < n; ++v) {
+        maybe_add_bitmap_row(v);
+    }
+}
+
+bool DYNAMIC_GRAPH::is_dense() const {
+    return dense;
+}
+
+const boost::dynamic_bitset<>& DYNAMIC_GRAPH::neighborhood_row(int v) const {
+    return bitmap_rows[bitmap_row[v]];
+}
+
+bool DYNAMIC_GRAPH::closed_neighborhood_contains(int v, boost::dynamic_bitset<>& vertex_set) const {
+    //v itself is in N[v] but not in its row.
+    const bool has_v = vertex_set[v];
+    vertex_set[v] = false;
+    const bool contained = vertex_set.is_subset_of(neighborhood_row(v));
+    vertex_set[v] = has_v;
+    return contained;
+}
+
+std::uint64_t DYNAMIC_GRAPH::closed_neighborhood_fingerprint(int v) const {
+    return fingerprint[v] | fingerprint_bit(v);
+}
@@ -0,0 +1,219 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <boost/dynamic_bitset.hpp>
+
+//Undirected graph for the reduction context, edges are deleted lazily.
+//removing an edge only clears its alive bit (O(1)), the dead entries stay in the neighborhoods until compact(),
+//so neighborhood iterators stay valid (and skip the edge) when edges are removed while iterating.
+//edge_exists is answered by an open addressing index of the connected vertex pairs, high degree vertices also get a bitmap row.
+//small dense graphs switch to dense mode: every vertex has a bitmap row (an adjacency matrix) for word parallel set tests.
+//every vertex has a 64 bit bloom fingerprint of its neighbors to reject containment tests without looking at the edges.
+class DYNAMIC_GRAPH {
+public:
+    struct adjacency_entry {
+        std::uint32_t target;
+        std::uint32_t edge_id;
+    };
+
+    struct edge_endpoints {
+        std::uint32_t source;
+        std::uint32_t target;
+    };
+
+    //iterates the live neighbors of a vertex, in insertion order.
+    class neighbor_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::size_t*;
+        using reference = std::size_t;
+
+        neighbor_iterator() : cur(nullptr), end(nullptr), alive(nullptr) {}
+
+        neighbor_iterator(const adjacency_entry* cur, const adjacency_entry* end, const std::vector<bool>* alive)
+            : cur(cur), end(end), alive(alive) {
+            skip_dead();
+        }
+
+        std::size_t operator*() const { return cur->target; }
+
+        //position in the neighborhood of the vertex, used by remove_edge(itt).
+        const adjacency_entry* entry() const { return cur; }
+
+        neighbor_iterator& operator++() {
+            ++cur;
+            skip_dead();
+            return *this;
+        }
+
+        neighbor_iterator operator++(int) {
+            neighbor_iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        bool operator==(const neighbor_iterator& other) const { return cur == other.cur; }
+        bool operator!=(const neighbor_iterator& other) const { return cur != other.cur; }
+        bool operator<(const neighbor_iterator& other) const { return cur < other.cur; }
+
+    private:
+        const adjacency_entry* cur;
+        const adjacency_entry* end;
+        const std::vector<bool>* alive;
+
+        void skip_dead() {
+            while (cur < end && !(*alive)[cur->edge_id]) {
+                ++cur;
+            }
+        }
+    };
+
+    //iterates the ids of the live edges, in insertion order.
+    class edge_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = int;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const int*;
+        using reference = int;
+
+        edge_iterator() : id(0), end(0), alive(nullptr) {}
+
+        edge_iterator(int id, int end, const std::vector<bool>* alive) : id(id), end(end), alive(alive) {
+            skip_dead();
+        }
+
+        int operator*() const { return id; }
+
+        edge_iterator& operator++() {
+            ++id;
+            skip_dead();
+            return *this;
+        }
+
+        bool operator==(const edge_iterator& other) const { return id == other.id; }
+        bool operator!=(const edge_iterator& other) const { return id != other.id; }
+        bool operator<(const edge_iterator& other) const { return id < other.id; }
+
+    private:
+        int id;
+        int end;
+        const std::vector<bool>* alive;
+
+        void skip_dead() {
+            while (id < end && !(*alive)[id]) {
+                ++id;
+            }
+        }
+    };
+
+    DYNAMIC_GRAPH();
+
+    explicit DYNAMIC_GRAPH(int n);
+
+    int num_vertices() const;
+
+    int num_edges() const;
+
+    //live degree, a self loop counts once.
+    int degree(int v) const;
+
+    std::pair<neighbor_iterator, neighbor_iterator> neighbors(int v) const;
+
+    std::pair<edge_iterator, edge_iterator> edges() const;
+
+    edge_endpoints endpoints(int edge_id) const;
+
+    int add_vertex();
+
+    int add_edge(int v, int w);
+
+    //O(1), independent of the order of the neighborhoods (edges added later are appended).
+    bool edge_exists(int v, int w) const;
+
+    //removes every (parallel) edge between v and w, O(1) per removed edge.
+    void remove_edge(int v, int w);
+
+    //removes the edge itt points to. O(1).
+    void remove_edge(const neighbor_iterator& itt);
+
+    //removes all edges of v, O(deg(v)).
+    void clear_vertex(int v);
+
+    //switches to dense mode if the graph is small and dense enough (see DENSE_MAX_VERTICES).
+    void maybe_make_dense();
+
+    bool is_dense() const;
+
+    //open neighborhood of v as bitset over all vertices, only in dense mode.
+    const boost::dynamic_bitset<>& neighborhood_row(int v) const;
+
+    //true if every vertex in vertex_set (num_vertices bits) is in N[v], only in dense mode.
+    bool closed_neighborhood_contains(int v, boost::dynamic_bitset<>& vertex_set) const;
+
+    //the bit of v in a fingerprint.
+    static std::uint64_t fingerprint_bit(int v) {
+        return std::uint64_t(1) << ((static_cast<std::uint64_t>(v) * 0x9E3779B97F4A7C15ULL) >> 58);
+    }
+
+    //union of the fingerprint bits of N[v]. the bits of removed neighbors stay set until compact(), so a vertex set
+    //with a bit outside of it is never contained in N[v], the other way round nothing is known.
+    std::uint64_t closed_neighborhood_fingerprint(int v) const;
+
+    //drops the dead entries and renumbers the edges (order is kept), invalidates all iterators.
+    void compact();
+
+    //compacts once more than half of the stored edges are dead, only call it where no iterator is in use.
+    void maybe_compact();
+
+    //heap memory of the graph (capacities, the hash index is estimated), for the memory statistics.
+    std::size_t memory_bytes() const;
+
+private:
+    std::vector<std::vector<adjacency_entry>> adjacency;
+    std::vector<edge_endpoints> edge_list;
+    std::vector<bool> alive;
+    std::vector<int> live_degree;
+    int num_live_edges;
+    std::vector<std::uint64_t> fingerprint;  // open neighborhood, see closed_neighborhood_fingerprint.
+
+    //one live edge per connected vertex pair, the other (parallel) edges between the pair follow in next_parallel,
+    //so all edges between a pair are found without scanning a neighborhood.
+    //linear probing table of edge ids (EDGE_NONE: empty slot), the key of a slot (min << 32 | max) is read from edge_list,
+    //so a slot is 4 bytes. the table is kept at most half full.
+    std::vector<std::uint32_t> pair_slots;
+    int pair_shift;                            // 64 - log2 of the number of slots.
+    std::size_t num_pairs;
+    std::vector<std::uint32_t> next_parallel;  // EDGE_NONE ends the list, only meaningful for live edges.
+    //index into bitmap_rows, -1 if the vertex has no bitmap row.
+    std::vector<int> bitmap_row;
+    std::vector<boost::dynamic_bitset<>> bitmap_rows;
+    bool dense;
+
+    static constexpr std::uint32_t EDGE_NONE = 0xFFFFFFFF;
+
+    void kill_edge(std::uint32_t edge_id);
+
+    static std::uint64_t edge_key(int v, int w);
+
+    //slot of the pair (v, w), or the empty slot where it would be inserted.
+    std::size_t find_pair(int v, int w) const;
+
+    std::size_t home_slot(std::uint64_t key) const;
+
+    //empties the slot, the following entries are shifted back (no tombstones).
+    void erase_pair(std::size_t slot);
+
+    //rebuilds the table with num_slots slots (a power of two) from the live edges.
+    void rebuild_pairs(std::size_t num_slots);
+
+    //creates the bitmap row of v once its degree is high enough for the row to be small compared to its neighborhood.
+    void maybe_add_bitmap_row(int v);
+
+    void set_bitmap_bit(int v, int w, bool value);
+};
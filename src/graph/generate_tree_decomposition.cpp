@@ -5,6 +5,7 @@
 #include <csignal>
 #include <memory>
 #include <chrono>
+#include <numeric>
 #include "generate_tree_decomposition.h"
 #include <queue>
 #include <boost/graph/connected_components.hpp>
@@ -84,6 +85,12 @@ public:
 };
 
 std::unique_ptr<NICE_TREE_DECOMPOSITION> generate_td_approx(adjacencyListBoost& reduced_graph)
+{
+    //the graph is only read from here on, so a CSR copy is used (also by the nice tree decomposition).
+    return generate_td_approx(parse::construct_CSR(reduced_graph));
+}
+
+std::unique_ptr<NICE_TREE_DECOMPOSITION> generate_td_approx(const CSR_GRAPH& csr)
 {
  //std::cout << "Generating tree decomposition..." << std::endl;
     //Create a management instance of the 'htd' library in order to allow centralized configuration.
@@ -95,18 +102,21 @@ std::unique_ptr<NICE_TREE_DECOMPOSITION> generate_td_approx(adjacencyListBoost&
     htd::IMutableMultiGraph * graph =
         manager->multiGraphFactory().createInstance();
 
-    //load in reduced_graph.
-    const uint num_graph = boost::num_vertices(reduced_graph);
+    //load in the graph.
+    const uint num_graph = csr.num_vertices;
     graph->addVertices(num_graph);
     int edge_counter = 0;
 
-    // Add two edges to the graph.
-    for (auto [itt_edge, itt_edge_end] = boost::edges(reduced_graph); itt_edge != itt_edge_end; ++itt_edge)
+    // Add two edges to the graph (every edge once, from its smaller endpoint).
+    for (int u = 0; u < csr.num_vertices; ++u)
     {
-        const uint target = boost::target(*itt_edge, reduced_graph) + 1;
-        const uint source = boost::source(*itt_edge, reduced_graph) + 1;
-        graph->addEdge(target, source);
-        edge_counter++;
+        auto [neigh_itt, neigh_itt_end] = csr.get_neighborhood(u);
+        for (; neigh_itt != neigh_itt_end; ++neigh_itt) {
+            if (*neigh_itt > static_cast<uint>(u)) {
+                graph->addEdge(*neigh_itt + 1, u + 1);
+                edge_counter++;
+            }
+        }
     }
 
     // Create an instance of the fitness function. (defined above)
@@ -256,7 +266,7 @@ std::unique_ptr<NICE_TREE_DECOMPOSITION> generate_td_approx(adjacencyListBoost&
                 htd::ITreeDecomposition * decomposition_strong = algorithm.computeDecomposition(*graph, [&](const htd::IMultiHypergraph & graph,
                                                    const htd::ITreeDecomposition & decomposition,
                                                    const htd::FitnessEvaluation & fitness){});
-                nice_tree_decomposition = std::make_unique<NICE_TREE_DECOMPOSITION>(reduced_graph, decomposition_strong);
+                nice_tree_decomposition = std::make_unique<NICE_TREE_DECOMPOSITION>(csr, decomposition_strong);
             }
             else if (decomposition->maximumBagSize() < 50){
                 std::cout << "treewidth L4" << std::endl;
@@ -276,6 +286,12 @@ std::unique_ptr<NICE_TREE_DECOMPOSITION> generate_td_approx(adjacencyListBoost&
 }
 
 std::unique_ptr<NICE_TREE_DECOMPOSITION> generate_td(adjacencyListBoost& reduced_graph)
+{
+    //the graph is only read from here on, so a CSR copy is used (also by the nice tree decomposition).
+    return generate_td(parse::construct_CSR(reduced_graph));
+}
+
+std::unique_ptr<NICE_TREE_DECOMPOSITION> generate_td(const CSR_GRAPH& csr)
 {
     std::cout << "Generating tree decomposition..." << std::endl;
     //Create a management instance of the 'htd' library in order to allow centralized configuration.
@@ -287,18 +303,21 @@ std::unique_ptr<NICE_TREE_DECOMPOSITION> generate_td(adjacencyListBoost& reduced
     htd::IMutableMultiGraph * graph =
         manager->multiGraphFactory().createInstance();
 
-    //load in reduced_graph.
-    const uint num_graph = boost::num_vertices(reduced_graph);
+    //load in the graph.
+    const uint num_graph = csr.num_vertices;
     graph->addVertices(num_graph);
     int edge_counter = 0;
 
-    // Add two edges to the graph.
-    for (auto [itt_edge, itt_edge_end] = boost::edges(reduced_graph); itt_edge != itt_edge_end; ++itt_edge)
+    // Add two edges to the graph (every edge once, from its smaller endpoint).
+    for (int u = 0; u < csr.num_vertices; ++u)
     {
-        const uint target = boost::target(*itt_edge, reduced_graph) + 1;
-        const uint source = boost::source(*itt_edge, reduced_graph) + 1;
-        graph->addEdge(target, source);
-        edge_counter++;
+        auto [neigh_itt, neigh_itt_end] = csr.get_neighborhood(u);
+        for (; neigh_itt != neigh_itt_end; ++neigh_itt) {
+            if (*neigh_itt > static_cast<uint>(u)) {
+                graph->addEdge(*neigh_itt + 1, u + 1);
+                edge_counter++;
+            }
+        }
     }
 
     // Create an instance of the fitness function. (defined above)
@@ -447,7 +466,7 @@ std::unique_ptr<NICE_TREE_DECOMPOSITION> generate_td(adjacencyListBoost& reduced
                 if (decomposition != nullptr){
                     if (!manager->isTerminated() || algorithm.isSafelyInterruptible()){
                         //std::cout << decomposition->maximumBagSize() << std::endl;
-                        nice_tree_decomposition = std::make_unique<NICE_TREE_DECOMPOSITION>(reduced_graph, decomposition);
+                        nice_tree_decomposition = std::make_unique<NICE_TREE_DECOMPOSITION>(csr, decomposition);
                         std::cout << "i want to read" << std::endl;
                     }
                 }
@@ -472,7 +491,7 @@ std::unique_ptr<NICE_TREE_DECOMPOSITION> generate_td(adjacencyListBoost& reduced
                     if (!manager->isTerminated() || algorithm.isSafelyInterruptible()){
                         std::cout << "actual running treewidth: "<< decomposition->maximumBagSize() - 1 << std::endl;
                         if (decomposition->maximumBagSize() - 1 <= 16){
-                            nice_tree_decomposition = std::make_unique<NICE_TREE_DECOMPOSITION>(reduced_graph, decomposition);
+                            nice_tree_decomposition = std::make_unique<NICE_TREE_DECOMPOSITION>(csr, decomposition);
                         } else {
                             Logger::treewidth.push_back(decomposition->maximumBagSize() - 1);
                             if (Logger::maximum_treewidth < decomposition->maximumBagSize() - 1){
@@ -498,3 +517,75 @@ std::unique_ptr<NICE_TREE_DECOMPOSITION> generate_td(adjacencyListBoost& reduced
     return nice_tree_decomposition;
 }
 
+std::unique_ptr<NICE_TREE_DECOMPOSITION> generate_td_precomputed(adjacencyListBoost& reduced_graph, const parse::td_file& td, const std::vector<int>& newToOriginal)
+{
+    return generate_td_precomputed(parse::construct_CSR(reduced_graph), td, newToOriginal);
+}
+
+std::unique_ptr<NICE_TREE_DECOMPOSITION> generate_td_precomputed(const CSR_GRAPH& csr, const parse::td_file& td, const std::vector<int>& newToOriginal)
+{
+    //same limit as generate_td, wider bags do not fit the encoding of the treewidth solver.
+    const int max_treewidth = 16;
+    std::vector<int> originalToNew(td.num_vertices, -1);
+    for (int v = 0; v < newToOriginal.size(); ++v) {
+        //vertices added by the reduction rules are not in the decomposition of the instance.
+        if (newToOriginal[v] < 0 || newToOriginal[v] >= td.num_vertices) {
+            return nullptr;
+        }
+        originalToNew[newToOriginal[v]] = v;
+    }
+
+    //restrict every bag to the vertices of the graph. the bags of one vertex stay a connected subtree, but the graph can be
+    //disconnected (a reduced view), then the kept bags form a forest.
+    std::vector<int> bag_index(td.bags.size(), -1);
+    std::vector<std::vector<int>> bags;
+    for (int b = 0; b < td.bags.size(); ++b) {
+        std::vector<int> bag;
+        for (int v : td.bags[b]) {
+            if (v >= 0 && v < td.num_vertices && originalToNew[v] != -1) {
+                bag.push_back(originalToNew[v]);
+            }
+        }
+        if (bag.empty()) {
+            continue;
+        }
+        if (bag.size() - 1 > max_treewidth) {
+            return nullptr;
+        }
+        bag_index[b] = bags.size();
+        bags.push_back(std::move(bag));
+    }
+    std::vector<std::pair<int, int>> tree_edges;
+    for (auto& [a, b] : td.tree_edges) {
+        if (a >= 0 && b >= 0 && a < bag_index.size() && b < bag_index.size() && bag_index[a] != -1 && bag_index[b] != -1) {
+            tree_edges.emplace_back(bag_index[a], bag_index[b]);
+        }
+    }
+    //the bags of a vertex (and of an edge) are in one tree of the forest, so linking the trees keeps the decomposition valid.
+    std::vector<int> root(bags.size());
+    std::iota(root.begin(), root.end(), 0);
+    auto find_root = [&root](int b) {
+        while (root[b] != b) {
+            root[b] = root[root[b]];
+            b = root[b];
+        }
+        return b;
+    };
+    for (auto& [a, b] : tree_edges) {
+        root[find_root(a)] = find_root(b);
+    }
+    for (int b = 1; b < static_cast<int>(bags.size()); ++b) {
+        if (find_root(b) != find_root(0)) {
+            tree_edges.emplace_back(find_root(0), b);
+            root[find_root(b)] = find_root(0);
+        }
+    }
+
+    //an invalid decomposition (not a tree, an uncovered vertex or edge, disconnected bags of a vertex) falls back to htd.
+    try {
+        return std::make_unique<NICE_TREE_DECOMPOSITION>(std::move(bags), std::move(tree_edges), csr);
+    } catch (const std::exception& e) {
+        std::cout << "precomputed tree decomposition rejected: " << e.what() << std::endl;
+        return nullptr;
+    }
+}
@@ -4,6 +4,7 @@
 
 #include <boost/graph/adjacency_list.hpp>
 #include "nice_tree_decomposition.h"
+#include "graph_io.h"
 
 typedef boost::adjacency_list<
     boost::vecS,                                  // Param:OutEdgeList (container used for edge-list (vector))
@@ -15,4 +16,16 @@ typedef boost::adjacency_list<
 
 std::unique_ptr<NICE_TREE_DECOMPOSITION> generate_td(adjacencyListBoost& reduced_graph);
 
+//the same on a read only graph, e.g. SUBGRAPH_VIEW::to_csr() of a component view.
+std::unique_ptr<NICE_TREE_DECOMPOSITION> generate_td(const CSR_GRAPH& csr);
+
 std::unique_ptr<NICE_TREE_DECOMPOSITION> generate_td_approx(adjacencyListBoost& reduced_graph);
+
+std::unique_ptr<NICE_TREE_DECOMPOSITION> generate_td_approx(const CSR_GRAPH& csr);
+
+//Nice tree decomposition of reduced_graph from a precomputed decomposition of the whole instance.
+//newToOriginal[v] is the vertex of the instance (0 indexed) for vertex v of reduced_graph, -1 if it has none (gadget).
+//Returns nullptr if the decomposition does not cover reduced_graph, or is too wide for the treewidth solver.
+std::unique_ptr<NICE_TREE_DECOMPOSITION> generate_td_precomputed(adjacencyListBoost& reduced_graph, const parse::td_file& td, const std::vector<int>& newToOriginal);
+
+std::unique_ptr<NICE_TREE_DECOMPOSITION> generate_td_precomputed(const CSR_GRAPH& csr, const parse::td_file& td, const std::vector<int>& newToOriginal);
@@ -0,0 +1,206 @@
+#include "graph_cache.h"
+
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string_view>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../util/mapped_file.h"
+
+namespace parse {
+    static_assert(sizeof(grb_header) == 80, "the .grb header has a fixed size of 80 bytes");
+
+    const char GRB_MAGIC[4] = { 'G', 'R', 'B', '\0' };
+
+    static std::string cache_directory;
+    static bool cache_full_checksum = false;
+
+    void configure_graph_cache(const std::string& directory, bool full_checksum) {
+        cache_directory = directory;
+        cache_full_checksum = full_checksum;
+    }
+
+    bool graph_cache_enabled() {
+        return !cache_directory.empty();
+    }
+
+    //absolute path without symlinks or . / .., the same instance reached by another path has the same cache.
+    static std::string canonical_source_path(const std::string& path) {
+        std::error_code error;
+        std::filesystem::path canonical = std::filesystem::weakly_canonical(std::filesystem::absolute(path, error), error);
+        if (error) {
+            return std::filesystem::absolute(path, error).lexically_normal().string();
+        }
+        return canonical.string();
+    }
+
+    //the source path is padded, so the offsets stay 8 byte aligned.
+    static std::size_t padded_path_bytes(std::uint64_t length) {
+        return static_cast<std::size_t>((length + 7) & ~std::uint64_t(7));
+    }
+
+    //exact_001.gr -> exact_001-<hash>.grb, the name is kept to find a cache by hand.
+    std::string get_cache_path(const std::string& path) {
+        const std::string source = canonical_source_path(path);
+        std::string name = std::filesystem::path(source).filename().string();
+        if (name.size() >= 3 && name.compare(name.size() - 3, 3, ".gr") == 0) {
+            name.resize(name.size() - 3);
+        }
+        char hash[17];
+        std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(checksum_words(source.data(), source.size(), 0)));
+        return (std::filesystem::path(cache_directory) / (name + "-" + hash + ".grb")).string();
+    }
+
+    bool stat_source(const std::string& path, std::uint64_t& size, std::int64_t& mtime) {
+        struct stat st;
+        if (stat(path.c_str(), &st) == -1 || !S_ISREG(st.st_mode)) {
+            return false;
+        }
+        size = st.st_size;
+        mtime = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+        return true;
+    }
+
+    //word at a time multiplicative hash, only meant to catch truncated or corrupted caches.
+    std::uint64_t checksum_words(const void* data, std::size_t size, std::uint64_t seed) {
+        const char* bytes = static_cast<const char*>(data);
+        std::uint64_t hash = seed ^ 0xcbf29ce484222325ULL;
+        std::size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, bytes + i, 8);
+            hash = (hash ^ word) * 0x9E3779B97F4A7C15ULL;
+            hash ^= hash >> 29;
+        }
+        for (; i < size; ++i) {
+            hash = (hash ^ static_cast<unsigned char>(bytes[i])) * 0x100000001b3ULL;
+        }
+        return hash;
+    }
+
+    bool load_graph_cache(const std::string& path, CSR_GRAPH& csr, long long& duplicates, long long& self_loops) {
+        std::uint64_t source_size;
+        std::int64_t source_mtime;
+        if (!graph_cache_enabled() || !stat_source(path, source_size, source_mtime)) {
+            return false;
+        }
+        const std::string source = canonical_source_path(path);
+        auto cache = std::make_shared<MAPPED_FILE>();
+        if (!cache->open(get_cache_path(path)) || cache->size() < sizeof(grb_header)) {
+            return false;
+        }
+        grb_header header;
+        std::memcpy(&header, cache->begin(), sizeof(grb_header));
+        if (std::memcmp(header.magic, GRB_MAGIC, 4) != 0 || header.version != GRB_VERSION) {
+            return false;
+        }
+        //the instance changed after the cache was written.
+        if (header.source_size != source_size || header.source_mtime != source_mtime) {
+            return false;
+        }
+        //the sizes are checked against the file before they are multiplied, a corrupt header can not overflow them.
+        if (header.num_vertices > INT_MAX || header.num_neighbors > cache->size() || header.source_path_length > cache->size()) {
+            return false;
+        }
+        const std::size_t path_bytes = padded_path_bytes(header.source_path_length);
+        const std::size_t offsets_bytes = (header.num_vertices + 1) * sizeof(std::uint64_t);
+        const std::size_t neighbors_bytes = header.num_neighbors * sizeof(std::uint32_t);
+        if (cache->size() != sizeof(grb_header) + path_bytes + offsets_bytes + neighbors_bytes) {
+            return false;
+        }
+        //another instance with the same cache name (hash collision).
+        const char* path_begin = cache->begin() + sizeof(grb_header);
+        if (std::string_view(path_begin, header.source_path_length) != source) {
+            return false;
+        }
+        //the header is 80 bytes and the path is padded, so the offsets (8 byte) and the neighbors (4 byte) are aligned in the page aligned mapping.
+        const char* offsets_begin = path_begin + path_bytes;
+        const char* neighbors_begin = offsets_begin + offsets_bytes;
+        const std::uint64_t* offsets = reinterpret_cast<const std::uint64_t*>(offsets_begin);
+        const std::uint32_t* neighbors = reinterpret_cast<const std::uint32_t*>(neighbors_begin);
+        if (offsets[0] != 0 || offsets[header.num_vertices] != header.num_neighbors) {
+            return false;
+        }
+        //the graph borrows these arrays unchecked: monotone offsets and sorted neighborhoods with vertices in range.
+        const std::uint32_t n = static_cast<std::uint32_t>(header.num_vertices);
+        for (std::uint32_t v = 0; v < n; ++v) {
+            if (offsets[v + 1] < offsets[v]) {
+                return false;
+            }
+            for (std::uint64_t i = offsets[v]; i < offsets[v + 1]; ++i) {
+                if (neighbors[i] >= n || (i > offsets[v] && neighbors[i] <= neighbors[i - 1])) {
+                    return false;
+                }
+            }
+        }
+        if (cache_full_checksum) {
+            std::uint64_t checksum = checksum_words(offsets_begin, offsets_bytes, 0);
+            checksum = checksum_words(neighbors_begin, neighbors_bytes, checksum);
+            if (checksum != header.checksum) {
+                return false;
+            }
+        }
+        cache->advise_normal_access();
+        csr = CSR_GRAPH(static_cast<int>(header.num_vertices), static_cast<long long>(header.num_edges), std::move(cache), offsets, neighbors);
+        duplicates = static_cast<long long>(header.num_duplicate_edges);
+        self_loops = static_cast<long long>(header.num_self_loops);
+        return true;
+    }
+
+    bool write_graph_cache(const std::string& path, const CSR_GRAPH& csr, long long duplicates, long long self_loops) {
+        if (!graph_cache_enabled()) {
+            return false;
+        }
+        grb_header header;
+        std::memset(&header, 0, sizeof(grb_header));
+        std::memcpy(header.magic, GRB_MAGIC, 4);
+        header.version = GRB_VERSION;
+        header.num_vertices = csr.num_vertices;
+        header.num_edges = csr.num_edges;
+        header.num_neighbors = csr.num_neighbors();
+        header.num_duplicate_edges = duplicates;
+        header.num_self_loops = self_loops;
+        if (!stat_source(path, header.source_size, header.source_mtime)) {
+            return false;
+        }
+        const std::string source = canonical_source_path(path);
+        header.source_path_length = source.size();
+        const std::string padding(padded_path_bytes(source.size()) - source.size(), '\0');
+        const std::size_t offsets_bytes = (static_cast<std::size_t>(csr.num_vertices) + 1) * sizeof(std::uint64_t);
+        const std::size_t neighbors_bytes = csr.num_neighbors() * sizeof(std::uint32_t);
+        header.checksum = checksum_words(csr.offset_data(), offsets_bytes, 0);
+        header.checksum = checksum_words(csr.neighbor_data(), neighbors_bytes, header.checksum);
+
+        //write to a temporary file first, so a concurrent run never maps a half written cache.
+        const std::string cache_path = get_cache_path(path);
+        std::error_code error;
+        std::filesystem::create_directories(cache_directory, error);
+        const std::string temp_path = cache_path + ".tmp" + std::to_string(getpid());
+        {
+            std::ofstream outFile(temp_path, std::ios::binary | std::ios::trunc);
+            if (!outFile) {
+                return false;
+            }
+            outFile.write(reinterpret_cast<const char*>(&header), sizeof(grb_header));
+            outFile.write(source.data(), source.size());
+            outFile.write(padding.data(), padding.size());
+            outFile.write(reinterpret_cast<const char*>(csr.offset_data()), offsets_bytes);
+            outFile.write(reinterpret_cast<const char*>(csr.neighbor_data()), neighbors_bytes);
+            if (!outFile) {
+                outFile.close();
+                std::remove(temp_path.c_str());
+                return false;
+            }
+        }
+        if (std::rename(temp_path.c_str(), cache_path.c_str()) != 0) {
+            std::remove(temp_path.c_str());
+            return false;
+        }
+        return true;
+    }
+}
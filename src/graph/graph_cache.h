@@ -0,0 +1,48 @@
+#pragma once
+#include <string>
+#include <cstdint>
+
+#include "csr_graph.h"
+
+//Binary cache (.grb) of a parsed PACE instance, so repeated runs on the same instance skip the text parser.
+//layout: grb_header | source path (padded to 8 bytes) | offsets (num_vertices + 1 x uint64) | neighbors (num_neighbors x uint32).
+//a loaded cache is not copied, the CSR_GRAPH borrows the arrays from the mapping.
+namespace parse {
+    //2: the cached graph is normalized (no parallel edges or self loops).
+    //3: the number of parallel edges and self loops removed while normalizing is stored in the header.
+    //4: the canonical path of the instance is stored after the header.
+    const std::uint32_t GRB_VERSION = 4;
+
+    struct grb_header {
+        char magic[4];                // "GRB\0"
+        std::uint32_t version;
+        std::uint64_t num_vertices;
+        std::uint64_t num_edges;
+        std::uint64_t num_neighbors;
+        std::uint64_t source_size;    // size of the .gr file the cache was created from.
+        std::int64_t source_mtime;    // modification time (ns) of the .gr file.
+        std::uint64_t checksum;       // checksum over the offsets and neighbors.
+        std::uint64_t num_duplicate_edges;  // edges dropped when the graph was normalized.
+        std::uint64_t num_self_loops;
+        std::uint64_t source_path_length;  // bytes of the canonical path of the .gr file (without padding).
+    };
+
+    //the cache is off unless a directory is configured (--cache=<dir>), nothing is written next to the instances.
+    //a loaded cache is always checked for monotone offsets and neighbors in range, so a corrupt cache can not cause out of bounds reads.
+    //full_checksum: loading also checks the checksum over the whole graph (catches corruption which stays in range).
+    void configure_graph_cache(const std::string& directory, bool full_checksum);
+
+    bool graph_cache_enabled();
+
+    //<cache directory>/exact_001-<hash of the canonical path>.grb for .../exact_001.gr, the path is also stored in the cache.
+    std::string get_cache_path(const std::string& path);
+
+    //returns false if there is no cache, or it is stale (source changed), from another version or corrupt.
+    //duplicates, self_loops: the edges dropped when the cached graph was normalized.
+    bool load_graph_cache(const std::string& path, CSR_GRAPH& csr, long long& duplicates, long long& self_loops);
+
+    //best effort: failing to write the cache (read-only directory) is not an error.
+    bool write_graph_cache(const std::string& path, const CSR_GRAPH& csr, long long duplicates, long long self_loops);
+
+    std::uint64_t checksum_words(const void* data, std::size_t size, std::uint64_t seed);
+}
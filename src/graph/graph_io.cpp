@@ -2,13 +2,179 @@
 #include "graph_io.h"
 #include <filesystem>
 #include <boost/graph/adjacency_list.hpp>
+#include <climits>
 #include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <functional>
+#include "../util/mapped_file.h"
+#include "../util/parallel.h"
+#include "graph_cache.h"
+#include "../util/output_sink.h"
+#include "../util/logger.h"
 
 
 namespace parse {
+    //below this size the serial scanner is faster than starting threads.
+    const std::size_t PARALLEL_PARSE_MIN_BYTES = 16 * 1024 * 1024;
+
+    //Scanner over an in-memory PACE file, it parses integers by hand and never allocates.
+    class pace_scanner {
+    public:
+        pace_scanner(const char* begin, const char* end) : cur(begin), end(end) {}
+
+        //finds the problem line (p ds n m) and reads the number of vertices and edges.
+        bool read_header(int& n, long long& m) {
+            while (cur < end) {
+                if (*cur == 'p') {
+                    ++cur;
+                    skip_word(); // problem descriptor (ds / tw).
+                    long long vertices;
+                    if (!read_uint(vertices) || !read_uint(m)) {
+                        return false;
+                    }
+                    n = static_cast<int>(vertices);
+                    return true;
+                }
+                skip_line();
+            }
+            return false;
+        }
+
+        //calls on_edge(u, v) (0 indexed) for every edge line, comment and problem lines are skipped.
+        template <typename F>
+        void for_each_edge(F&& on_edge) {
+            while (cur < end) {
+                const char c = *cur;
+                if (c == 'c' || c == 'p' || c == '\n' || c == '\r') {
+                    skip_line();
+                    continue;
+                }
+                long long u, v;
+                if (!read_uint(u)) {
+                    //blank (whitespace only) lines are allowed.
+                    skip_blanks();
+                    if (cur < end && *cur != '\n' && *cur != '\r') {
+                        throw std::invalid_argument("Malformed edge line");
+                    }
+                    skip_line();
+                    continue;
+                }
+                if (!read_uint(v)) {
+                    throw std::invalid_argument("Malformed edge line");
+                }
+                on_edge(static_cast<std::uint32_t>(u - 1), static_cast<std::uint32_t>(v - 1));
+                skip_line();
+            }
+        }
+
+    private:
+        const char* cur;
+        const char* end;
+
+        void skip_line() {
+            const void* newline = std::memchr(cur, '\n', end - cur);
+            cur = (newline == nullptr) ? end : static_cast<const char*>(newline) + 1;
+        }
+
+        void skip_blanks() {
+            while (cur < end && (*cur == ' ' || *cur == '\t')) {
+                ++cur;
+            }
+        }
+
+        void skip_word() {
+            skip_blanks();
+            while (cur < end && *cur != ' ' && *cur != '\t' && *cur != '\n' && *cur != '\r') {
+                ++cur;
+            }
+        }
+
+        bool read_uint(long long& value) {
+            skip_blanks();
+            if (cur == end || *cur < '0' || *cur > '9') {
+                return false;
+            }
+            long long result = 0;
+            while (cur < end && *cur >= '0' && *cur <= '9') {
+                result = result * 10 + (*cur - '0');
+                //vertex ids and counts fit an int, this also stops overlong digit runs before they overflow.
+                if (result > INT_MAX) {
+                    throw std::invalid_argument("Number out of range");
+                }
+                ++cur;
+            }
+            value = result;
+            return true;
+        }
+    };
+
+    //parallel edges and self loops are dropped while loading, the reduction rules never see them.
+    //stderr: stdout can be the solution sink.
+    void report_removed_edges(long long duplicates, long long self_loops) {
+        Logger::cnt_duplicate_edges += duplicates;
+        Logger::cnt_self_loops += self_loops;
+        if (duplicates > 0 || self_loops > 0) {
+            std::cerr << "removed " << duplicates << " duplicate edges and " << self_loops << " self loops" << std::endl;
+        }
+    }
+
+    //edges in (min, max) order, LSD radix sorted (8 bit digits) and without self loops and duplicates, in O(m).
+    void normalize_edge_list(int n, std::vector<std::pair<int, int>>& edges) {
+        long long self_loops = 0;
+        std::vector<std::uint64_t> keys;
+        keys.reserve(edges.size());
+        for (auto& [u, v] : edges) {
+            if (u == v) {
+                self_loops++;
+                continue;
+            }
+            const std::uint64_t low = std::min(u, v);
+            const std::uint64_t high = std::max(u, v);
+            keys.push_back((low << 32) | high);
+        }
+
+        //both halves of the key are vertex ids, only the digits n - 1 needs are sorted.
+        int digits = 0;
+        for (std::uint64_t max_vertex = (n > 0) ? n - 1 : 0; max_vertex > 0; max_vertex >>= 8) {
+            digits++;
+        }
+        std::vector<std::uint64_t> buffer(keys.size());
+        for (int half = 0; half < 2; ++half) {
+            for (int d = 0; d < digits; ++d) {
+                const int shift = half * 32 + d * 8;
+                std::size_t count[257] = {};
+                for (std::uint64_t key : keys) {
+                    count[((key >> shift) & 0xFF) + 1]++;
+                }
+                for (int i = 0; i < 256; ++i) {
+                    count[i + 1] += count[i];
+                }
+                for (std::uint64_t key : keys) {
+                    buffer[count[(key >> shift) & 0xFF]++] = key;
+                }
+                keys.swap(buffer);
+            }
+        }
+        const std::size_t num_keys = keys.size();
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        report_removed_edges(static_cast<long long>(num_keys - keys.size()), self_loops);
+
+        edges.resize(keys.size());
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            edges[i] = { static_cast<int>(keys[i] >> 32), static_cast<int>(keys[i] & 0xFFFFFFFF) };
+        }
+    }
+
+    void normalize_graph(CSR_GRAPH& csr, long long& duplicates, long long& self_loops) {
+        csr.remove_duplicate_edges(duplicates, self_loops);
+        report_removed_edges(duplicates, self_loops);
+    }
+
     adjacencyListBoost construct_AdjacencyList_Boost(int n, std::vector<std::pair<int, int>> edges) {
         adjacencyListBoost g(n);
-        std::sort(edges.begin(), edges.end());
+        normalize_edge_list(n, edges);
         //adjacencyList is sorted.
         for (auto& p : edges) {
             boost::add_edge(p.first, p.second, g);
@@ -20,14 +186,14 @@ namespace parse {
         std::vector<std::pair<int, int>> edges;
 
         int i = 0;
-        int n; // 
+        int n = -1; // 
         long long m;
         int u, v;
         std::string s;
         
         //Assumption : no spaces before the first letter.
         for (std::string line; std::getline(is, line);) {
-            if (line.empty()) continue;
+            if (line.find_first_not_of(" \t\r") == std::string::npos) continue; // blank lines are allowed.
 
             if (line[i] == 'c') continue;  // ignore comments
 
@@ -35,129 +201,426 @@ namespace parse {
             if (line[i] == 'p') {
                 ss >> s >> s >> n >> m;
             } else {
-                ss >> u >> v;
+                if (n < 0) {
+                    throw std::invalid_argument("Missing problem line (p ds n m)");
+                }
+                if (!(ss >> u >> v)) {
+                    throw std::invalid_argument("Malformed edge line");
+                }
+                //same 1..n check as the mmap and chunked parsers, normalize_edge_list expects valid vertices.
+                if (u < 1 || u > n || v < 1 || v > n) {
+                    throw std::invalid_argument("Vertex index out of range");
+                }
                 edges.push_back({ u - 1, v - 1 });
             }
         }
+        if (n < 0) {
+            throw std::invalid_argument("Missing problem line (p ds n m)");
+        }
         return construct_AdjacencyList_Boost(n, edges);
     }
 
-    adjacencyListBoost load_pace_2024(std::string path) {
+    td_file read_pace_td(std::istream& is) {
+        td_file td;
+        td.num_vertices = -1;
+        std::string s;
+        for (std::string line; std::getline(is, line);) {
+            if (line.empty() || line[0] == 'c' || line[0] == '\r') continue;
+
+            auto ss = std::stringstream(line);
+            if (line[0] == 's') {
+                int num_bags, max_bag_size;
+                ss >> s >> s >> num_bags >> max_bag_size >> td.num_vertices;
+                td.bags.resize(num_bags);
+                td.tree_edges.reserve(num_bags > 0 ? num_bags - 1 : 0);
+            } else if (line[0] == 'b') {
+                int index, v;
+                ss >> s >> index;
+                if (index < 1 || static_cast<std::size_t>(index) > td.bags.size()) {
+                    throw std::invalid_argument("Bag index out of range");
+                }
+                while (ss >> v) {
+                    td.bags[index - 1].push_back(v - 1);
+                }
+            } else {
+                int a, b;
+                if (!(ss >> a >> b)) {
+                    throw std::invalid_argument("Malformed tree edge line");
+                }
+                td.tree_edges.push_back({ a - 1, b - 1 });
+            }
+        }
+        if (td.num_vertices < 0) {
+            throw std::invalid_argument("Missing solution line (s td b w n)");
+        }
+        return td;
+    }
+
+    td_file load_pace_td(const std::string& path) {
         std::ifstream f(path);
         if (f.fail()) {
             throw std::invalid_argument("Failed to open file");
         }
-        //return read_pace_2024(f);
-        return read_pace_2024(f);
+        return read_pace_td(f);
     }
 
-    void output_reduced_graph_instance(adjacencyListBoost& reduced_graph, std::string& path) {
-        std::string prefix = "/mnt/c/Users/Flori/OneDrive/Documenten/GitHub/minimum-dominating-set/output/reduced_instances/reduced_instance_";
-        std::string name = getNameFile(path);
-        std::string output_path = prefix + name;
+    std::string get_td_path(const std::string& path) {
+        if (path.size() > 3 && path.compare(path.size() - 3, 3, ".gr") == 0) {
+            return path.substr(0, path.size() - 3) + ".td";
+        }
+        return path + ".td";
+    }
 
-        std::ofstream outFile(output_path);
+    adjacencyListBoost load_pace_2024(std::string path, parse_mode mode, bool use_cache) {
+        if (mode == PARSE_STREAM) {
+            std::ifstream f(path);
+            if (f.fail()) {
+                throw std::invalid_argument("Failed to open file");
+            }
+            return read_pace_2024(f);
+        }
+        return construct_AdjacencyList_Boost(load_pace_2024_csr(path, mode, use_cache));
+    }
 
-        if (!outFile) {
-            printf("error with writing to file");
-            return;
+    CSR_GRAPH load_pace_2024_csr(const std::string& path, parse_mode mode, bool use_cache) {
+        CSR_GRAPH csr;
+        long long duplicates, self_loops;
+        use_cache = use_cache && path != "-";
+        if (use_cache && load_graph_cache(path, csr, duplicates, self_loops)) {
+            report_removed_edges(duplicates, self_loops);
+            return csr;
         }
+        MAPPED_FILE file;
+        if (path != "-" && file.open(path) && !INPUT_STREAM::is_gzip(file.begin(), file.end())) {
+            //small files are not worth starting threads for.
+            if (mode == PARSE_MMAP_PARALLEL && file.size() >= PARALLEL_PARSE_MIN_BYTES) {
+                csr = read_pace_2024_parallel(file.begin(), file.end(), available_threads());
+            } else {
+                csr = read_pace_2024_mmap(file.begin(), file.end());
+            }
+            normalize_graph(csr, duplicates, self_loops);
+            if (use_cache) {
+                write_graph_cache(path, csr, duplicates, self_loops);
+            }
+            return csr;
+        }
+        //not a regular file (stdin, pipe) or compressed.
+        const bool regular_file = file.is_open();
+        file.close();
+        INPUT_STREAM input(path);
+        csr = read_pace_2024_stream(input);
+        normalize_graph(csr, duplicates, self_loops);
+        if (use_cache && regular_file) {
+            write_graph_cache(path, csr, duplicates, self_loops);
+        }
+        return csr;
+    }
+
+    CSR_GRAPH read_pace_2024_stream(INPUT_STREAM& input) {
+        int n = 0;
+        long long m = 0;
+        bool header_found = false;
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+
+        auto scan_lines = [&](const char* begin, const char* end) {
+            pace_scanner scanner(begin, end);
+            if (!header_found) {
+                header_found = scanner.read_header(n, m);
+                if (!header_found) {
+                    return;
+                }
+                //m is not trusted, an edge line needs at least 4 bytes and the size of the input is unknown here.
+                edges.reserve(std::min<long long>(m, INPUT_STREAM::CHUNK_SIZE / 4));
+            }
+            scanner.for_each_edge([&](std::uint32_t u, std::uint32_t v) {
+                if (u >= static_cast<std::uint32_t>(n) || v >= static_cast<std::uint32_t>(n)) {
+                    throw std::invalid_argument("Vertex index out of range");
+                }
+                edges.emplace_back(u, v);
+            });
+        };
 
+        //blocks end anywhere, the unfinished last line is kept until the next block arrives.
+        std::vector<char> chunk;
+        std::string partial_line;
+        while (input.next_chunk(chunk)) {
+            const char* begin = chunk.data();
+            const char* end = begin + chunk.size();
+            if (!partial_line.empty()) {
+                const void* newline = std::memchr(begin, '\n', end - begin);
+                const char* line_end = (newline == nullptr) ? end : static_cast<const char*>(newline) + 1;
+                partial_line.append(begin, line_end);
+                begin = line_end;
+                if (newline == nullptr) {
+                    continue;
+                }
+                scan_lines(partial_line.data(), partial_line.data() + partial_line.size());
+                partial_line.clear();
+            }
+            const char* last_line = end;
+            while (last_line > begin && last_line[-1] != '\n') {
+                --last_line;
+            }
+            scan_lines(begin, last_line);
+            partial_line.assign(last_line, end);
+        }
+        scan_lines(partial_line.data(), partial_line.data() + partial_line.size());
+        if (!header_found) {
+            throw std::invalid_argument("Missing problem line (p ds n m)");
+        }
+
+        //counting sort of both endpoints by vertex, same layout as read_pace_2024_mmap.
+        std::vector<std::uint64_t> offsets(n + 1, 0);
+        for (auto& [u, v] : edges) {
+            offsets[u + 1]++;
+            if (u != v) {
+                offsets[v + 1]++;
+            }
+        }
+        for (int i = 0; i < n; ++i) {
+            offsets[i + 1] += offsets[i];
+        }
+        std::vector<std::uint32_t> neighbors(offsets[n]);
+        std::vector<std::uint64_t> position(offsets.begin(), offsets.end() - 1);
+        for (auto& [u, v] : edges) {
+            neighbors[position[u]++] = v;
+            if (u != v) {
+                neighbors[position[v]++] = u;
+            }
+        }
+        const long long num_edges = edges.size();
+        std::vector<std::pair<std::uint32_t, std::uint32_t>>().swap(edges);
+
+        CSR_GRAPH csr(n, num_edges, std::move(offsets), std::move(neighbors));
+        csr.sort_neighborhoods();
+        return csr;
+    }
+
+    CSR_GRAPH read_pace_2024_parallel(const char* begin, const char* end, int num_threads) {
+        if (num_threads <= 1) {
+            return read_pace_2024_mmap(begin, end);
+        }
+        int n = 0;
+        long long m = 0;
+        pace_scanner header(begin, end);
+        if (!header.read_header(n, m)) {
+            throw std::invalid_argument("Missing problem line (p ds n m)");
+        }
+
+        //split the file in chunks which start at the beginning of a line.
+        std::vector<const char*> chunk_begin(num_threads + 1, end);
+        chunk_begin[0] = begin;
+        const std::size_t chunk_size = (end - begin) / num_threads;
+        for (int t = 1; t < num_threads; ++t) {
+            const char* split = std::max(chunk_begin[t - 1], begin + t * chunk_size);
+            const void* newline = std::memchr(split, '\n', end - split);
+            chunk_begin[t] = (newline == nullptr) ? end : static_cast<const char*>(newline) + 1;
+        }
+
+        //every thread owns a block of vertices: their offsets, positions and neighborhoods.
+        const int block = std::max(1, (n + num_threads - 1) / num_threads);
+        auto owner = [block](std::uint32_t v) { return static_cast<int>(v / block); };
+
+        //parse every chunk into one edge buffer per owner, both directions of an edge go to the owner of its source.
+        std::vector<std::vector<std::vector<std::pair<std::uint32_t, std::uint32_t>>>> buckets(num_threads);
+        std::vector<long long> chunk_edges(num_threads, 0);
+        run_parallel(num_threads, [&](int t) {
+            auto& chunk_buckets = buckets[t];
+            chunk_buckets.resize(num_threads);
+            for (auto& bucket : chunk_buckets) {
+                bucket.reserve((chunk_begin[t + 1] - chunk_begin[t]) / 4 / num_threads);
+            }
+            pace_scanner(chunk_begin[t], chunk_begin[t + 1]).for_each_edge([&](std::uint32_t u, std::uint32_t v) {
+                if (u >= static_cast<std::uint32_t>(n) || v >= static_cast<std::uint32_t>(n)) {
+                    throw std::invalid_argument("Vertex index out of range");
+                }
+                chunk_buckets[owner(u)].emplace_back(u, v);
+                if (u != v) {
+                    chunk_buckets[owner(v)].emplace_back(v, u);
+                }
+                chunk_edges[t]++;
+            });
+        });
+        long long num_edges = 0;
+        for (long long edges : chunk_edges) {
+            num_edges += edges;
+        }
+
+        //every thread counts the degrees of its own vertices.
+        std::vector<std::uint64_t> offsets(n + 1, 0);
+        run_parallel(num_threads, [&](int t) {
+            for (int q = 0; q < num_threads; ++q) {
+                for (auto& [u, v] : buckets[q][t]) {
+                    offsets[u + 1]++;
+                }
+            }
+        });
+        for (int v = 0; v < n; ++v) {
+            offsets[v + 1] += offsets[v];
+        }
+
+        //scatter and sort, the neighborhoods of different blocks never overlap so no synchronisation is needed.
+        std::vector<std::uint32_t> neighbors(offsets[n]);
+        run_parallel(num_threads, [&](int t) {
+            const int first = std::min(n, t * block);
+            const int last = std::min(n, first + block);
+            std::vector<std::uint64_t> position(offsets.begin() + first, offsets.begin() + last);
+            for (int q = 0; q < num_threads; ++q) {
+                for (auto& [u, v] : buckets[q][t]) {
+                    neighbors[position[u - first]++] = v;
+                }
+                std::vector<std::pair<std::uint32_t, std::uint32_t>>().swap(buckets[q][t]);
+            }
+            for (int v = first; v < last; ++v) {
+                std::sort(neighbors.begin() + offsets[v], neighbors.begin() + offsets[v + 1]);
+            }
+        });
+        return CSR_GRAPH(n, num_edges, std::move(offsets), std::move(neighbors));
+    }
+
+    CSR_GRAPH read_pace_2024_mmap(const char* begin, const char* end) {
+        int n = 0;
+        long long m = 0;
+        pace_scanner header(begin, end);
+        if (!header.read_header(n, m)) {
+            throw std::invalid_argument("Missing problem line (p ds n m)");
+        }
+
+        //first pass: count the degree of every vertex.
+        std::vector<std::uint64_t> offsets(n + 1, 0);
+        long long num_edges = 0;
+        pace_scanner(begin, end).for_each_edge([&](std::uint32_t u, std::uint32_t v) {
+            if (u >= static_cast<std::uint32_t>(n) || v >= static_cast<std::uint32_t>(n)) {
+                throw std::invalid_argument("Vertex index out of range");
+            }
+            offsets[u + 1]++;
+            if (u != v) {
+                offsets[v + 1]++;
+            }
+            num_edges++;
+        });
+        for (int i = 0; i < n; ++i) {
+            offsets[i + 1] += offsets[i];
+        }
+
+        //second pass: scatter both endpoints into their neighborhoods.
+        std::vector<std::uint32_t> neighbors(offsets[n]);
+        std::vector<std::uint64_t> position(offsets.begin(), offsets.end() - 1);
+        pace_scanner(begin, end).for_each_edge([&](std::uint32_t u, std::uint32_t v) {
+            neighbors[position[u]++] = v;
+            if (u != v) {
+                neighbors[position[v]++] = u;
+            }
+        });
+
+        CSR_GRAPH csr(n, num_edges, std::move(offsets), std::move(neighbors));
+        csr.sort_neighborhoods();
+        return csr;
+    }
+
+    adjacencyListBoost construct_AdjacencyList_Boost(const CSR_GRAPH& csr) {
+        adjacencyListBoost g(csr.num_vertices);
+        //edges are added in increasing (source, target) order, so every adjacencyList stays sorted.
+        for (int u = 0; u < csr.num_vertices; ++u) {
+            auto [neigh_itt, neigh_itt_end] = csr.get_neighborhood(u);
+            for (; neigh_itt != neigh_itt_end; ++neigh_itt) {
+                if (*neigh_itt >= static_cast<std::uint32_t>(u)) {
+                    boost::add_edge(u, *neigh_itt, g);
+                }
+            }
+        }
+        return g;
+    }
+
+    CSR_GRAPH construct_CSR(const adjacencyListBoost& g) {
+        const int n = boost::num_vertices(g);
+        std::vector<std::uint64_t> offsets(n + 1, 0);
+        for (int v = 0; v < n; ++v) {
+            offsets[v + 1] = offsets[v] + boost::out_degree(v, g);
+        }
+        std::vector<std::uint32_t> neighbors(offsets[n]);
+        for (int v = 0; v < n; ++v) {
+            std::uint64_t position = offsets[v];
+            for (auto [neigh_itt, neigh_itt_end] = boost::adjacent_vertices(v, g); neigh_itt != neigh_itt_end; ++neigh_itt) {
+                neighbors[position++] = static_cast<std::uint32_t>(*neigh_itt);
+            }
+        }
+        CSR_GRAPH csr(n, boost::num_edges(g), std::move(offsets), std::move(neighbors));
+        csr.sort_neighborhoods();
+        long long duplicates, self_loops;
+        csr.remove_duplicate_edges(duplicates, self_loops);
+        return csr;
+    }
+
+    void output_reduced_graph_instance(adjacencyListBoost& reduced_graph, std::string& path) {
         int num_vertices = boost::num_vertices(reduced_graph);
         int num_edges = boost::num_edges(reduced_graph);
         auto [all_edge_itt, all_edge_itt_end] = boost::edges(reduced_graph);
 
-        outFile << "p tw " << num_vertices << " " << num_edges << std::endl;
+        OUTPUT_BUFFER buffer;
+        buffer.reserve(32 + static_cast<std::size_t>(num_edges) * 16);
+        buffer.append("p tw ").append(static_cast<long long>(num_vertices)).append(' ').append(static_cast<long long>(num_edges)).append('\n');
         for (;all_edge_itt != all_edge_itt_end; ++all_edge_itt) {
             int source = boost::source(*all_edge_itt, reduced_graph);
             int target = boost::target(*all_edge_itt, reduced_graph);
 
-            outFile << (source + 1) << " " << (target + 1) << std::endl;
+            buffer.append(static_cast<long long>(source + 1)).append(' ').append(static_cast<long long>(target + 1)).append('\n');
         }
-        outFile.close();
+        OUTPUT_SINK::write("reduced_instance_" + getNameFile(path), buffer);
     }
 
     void output_solution(std::vector<int>& solution, std::string& path) {
-        std::string prefix = "/home/floris/github/minimum-dominating-set/output/solutions/solution_";
-        std::string name = getNameFile(path);
-        //assumption the graph always has the .gr extention.
-        std::string new_name = name.substr(0, name.size() - 3) + ".sol";
-        std::string output_path = prefix + new_name;
-
-        std::ofstream outFile(output_path);
-
-        if (!outFile) {
-            printf("error with writing to file");
-            return;
-        }
+        OUTPUT_BUFFER buffer;
+        buffer.reserve(16 + solution.size() * 12);
         // print the solution size on the first line.
-        int size_solution = solution.size();
-        outFile << size_solution << std::endl;
+        buffer.append(static_cast<long long>(solution.size())).append('\n');
 
         //print solution line for line.
         for (int i : solution) {
-            outFile << i << std::endl;
+            buffer.append(static_cast<long long>(i)).append('\n');
         }
+        OUTPUT_SINK::write(getSolutionName(path), buffer);
+    }
 
-
-        outFile.close();
+    void append_state_vector(OUTPUT_BUFFER& buffer, const char* label, MDS_CONTEXT& mds_context, std::uint8_t flag) {
+        buffer.append(label).append(' ');
+        for (std::uint8_t s : mds_context.state) {
+            buffer.append(static_cast<long long>((s & flag) != 0)).append(' ');
+        }
+        buffer.append('\n');
     }
 
     void output_context(MDS_CONTEXT& mds_context, std::string& path) {
-        std::string prefix = "/mnt/c/Users/Flori/OneDrive/Documenten/GitHub/minimum-dominating-set/output/reduced_"; //TODO:: TEMPORARY
-        std::string name = getNameFile(path);
-        std::string output_path = prefix + name;
-
-        std::ofstream outFile(output_path);
-
-        if (!outFile) {
-            printf("error with writing to file");
-            return;
-        }
-
-        //write domination
-        outFile << "dominated ";
-        for (int i : mds_context.dominated) {
-            outFile << i << " ";
-        }
-        outFile << std::endl;
-        //write removed
-        outFile << "removed ";
-        for (int i : mds_context.removed) {
-            outFile << i << " ";
-        }
-        outFile << std::endl;
-        //write ignored
-        outFile << "ignored ";
-        for (int i : mds_context.ignored) {
-            outFile << i << " ";
-        }
-        outFile << std::endl;
-        outFile << "excluded ";
-        for (int i : mds_context.excluded) {
-            outFile << i << " ";
-        }
-        outFile << std::endl;
-        //todo: included
-        outFile << "included ";
-        for (int i : mds_context.selected) {
-            outFile << i << " ";
-        }
-        outFile << std::endl;
-        //WRITE ADJACENCYGRAPH (Format to be determined)
+        OUTPUT_BUFFER buffer;
         size_t num_vertices = mds_context.get_total_vertices();
         size_t num_edges = mds_context.get_total_edges();
+        buffer.reserve(64 + 5 * num_vertices * 2 + num_edges * 16);
+
+        append_state_vector(buffer, "dominated", mds_context, STATE_DOMINATED);
+        append_state_vector(buffer, "removed", mds_context, STATE_REMOVED);
+        append_state_vector(buffer, "ignored", mds_context, STATE_IGNORED);
+        append_state_vector(buffer, "excluded", mds_context, STATE_EXCLUDED);
+        append_state_vector(buffer, "included", mds_context, STATE_SELECTED);
 
+        //WRITE ADJACENCYGRAPH (Format to be determined)
         auto [edges_itt, edge_itt_end] = mds_context.get_edge_itt();
 
-        outFile << "p ds " << num_vertices << " " << num_edges << std::endl;
+        buffer.append("p ds ").append(static_cast<long long>(num_vertices)).append(' ').append(static_cast<long long>(num_edges)).append('\n');
         for (; edges_itt != edge_itt_end; ++edges_itt) {
             vertex source = mds_context.get_source_edge(*edges_itt);
             vertex target = mds_context.get_target_edge(*edges_itt);
-            outFile << source << " " << target << std::endl;
+            buffer.append(static_cast<long long>(source)).append(' ').append(static_cast<long long>(target)).append('\n');
         }
+        OUTPUT_SINK::write("reduced_" + getNameFile(path), buffer);
+    }
 
-        outFile.close();
+    //exact_001.gr -> solution_exact_001.sol
+    std::string getSolutionName(std::string& path) {
+        std::string name = (path == "-") ? "stdin" : getNameFile(path);
+        if (name.size() > 3 && name.compare(name.size() - 3, 3, ".gr") == 0) {
+            name = name.substr(0, name.size() - 3);
+        }
+        return "solution_" + name + ".sol";
     }
 
     std::string getNameFile(std::string& path) {
@@ -4,17 +4,64 @@
 #include <sstream>
 
 #include "context.h"
+#include "csr_graph.h"
+#include "../util/input_stream.h"
 
 namespace parse {
+    enum parse_mode {
+        PARSE_STREAM,        // std::getline based reader.
+        PARSE_MMAP,          // memory mapped scanner which builds the CSR arrays directly.
+        PARSE_MMAP_PARALLEL  // memory mapped, the edge lines are split in chunks and parsed on all available cores.
+    };
+
+    //PACE tree decomposition (.td): bags with 0 indexed vertices, tree edges between 0 indexed bags.
+    struct td_file {
+        int num_vertices;
+        std::vector<std::vector<int>> bags;
+        std::vector<std::pair<int, int>> tree_edges;
+    };
+
     adjacencyListBoost read_pace_2024(std::istream& is);
 
-    adjacencyListBoost load_pace_2024(std::string path);
+    td_file read_pace_td(std::istream& is);
+
+    td_file load_pace_td(const std::string& path);
+
+    //instance.gr -> instance.td
+    std::string get_td_path(const std::string& path);
+
+    CSR_GRAPH read_pace_2024_mmap(const char* begin, const char* end);
+
+    CSR_GRAPH read_pace_2024_parallel(const char* begin, const char* end, int num_threads);
+
+    //parses the blocks of a (possibly gzip compressed) stream while the next blocks are read in the background.
+    CSR_GRAPH read_pace_2024_stream(INPUT_STREAM& input);
 
+    //path "-" reads stdin, pipes and gzip compressed instances (.gr.gz) are streamed instead of mapped.
+    //use_cache: load from (and after parsing write) the binary .grb cache, if a cache directory is configured.
+    CSR_GRAPH load_pace_2024_csr(const std::string& path, parse_mode mode = PARSE_MMAP_PARALLEL, bool use_cache = true);
+
+    //sorts the edges in (min, max) order and drops self loops and duplicates, the counts go to the Logger.
+    void normalize_edge_list(int n, std::vector<std::pair<int, int>>& edges);
+
+    //same for a CSR graph, the counts are also returned so they can be stored in the .grb cache.
+    void normalize_graph(CSR_GRAPH& csr, long long& duplicates, long long& self_loops);
+
+    adjacencyListBoost construct_AdjacencyList_Boost(const CSR_GRAPH& csr);
+
+    //read only copy (sorted neighborhoods, without parallel edges and self loops) for phases which never change the graph.
+    CSR_GRAPH construct_CSR(const adjacencyListBoost& g);
+
+    adjacencyListBoost load_pace_2024(std::string path, parse_mode mode = PARSE_MMAP_PARALLEL, bool use_cache = true);
+
+    //the writers below format into one buffer and hand it to the configured OUTPUT_SINK.
     void output_context(MDS_CONTEXT& mds_context, std::string& path);
 
     void output_reduced_graph_instance(adjacencyListBoost& reduced_graph, std::string& path);
 
     std::string getNameFile(std::string& path);
 
+    std::string getSolutionName(std::string& path);
+
     void output_solution(std::vector<int>& solution, std::string& path);
 } 
@@ -0,0 +1,218 @@
+#include "kernel_io.h"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace parse {
+    void KERNEL_WRITER::add(MDS_CONTEXT& mds_context, const std::vector<int>& kernelToOriginal) {
+        const int component_vertices = mds_context.get_total_vertices();
+        if (kernelToOriginal.size() != static_cast<std::size_t>(component_vertices)) {
+            throw std::invalid_argument("kernelToOriginal must have an entry for every vertex");
+        }
+        const long long first = num_vertices;
+        for (int v = 0; v < component_vertices; ++v) {
+            int flags = 0;
+            if (mds_context.has_state(v, STATE_SELECTED)) flags |= KERNEL_SELECTED;
+            if (mds_context.has_state(v, STATE_DOMINATED)) flags |= KERNEL_DOMINATED;
+            if (mds_context.has_state(v, STATE_REMOVED)) flags |= KERNEL_REMOVED;
+            if (mds_context.has_state(v, STATE_EXCLUDED)) flags |= KERNEL_EXCLUDED;
+            if (mds_context.has_state(v, STATE_IGNORED)) flags |= KERNEL_IGNORED;
+            //the counters are stored as well, they refer to edges which remove_vertex already deleted.
+            vertex_lines.append("v ").append(static_cast<long long>(kernelToOriginal[v] + 1)).append(' ').append(static_cast<long long>(flags));
+            vertex_lines.append(' ').append(static_cast<long long>(mds_context.counters[v].c_d)).append(' ').append(static_cast<long long>(mds_context.counters[v].c_nd));
+            vertex_lines.append(' ').append(static_cast<long long>(mds_context.counters[v].c_x)).append('\n');
+        }
+
+        //the edge order is kept, so the reduction rules see the same adjacency order after loading.
+        auto [edges_itt, edge_itt_end] = mds_context.get_edge_itt();
+        for (; edges_itt != edge_itt_end; ++edges_itt) {
+            vertex source = mds_context.get_source_edge(*edges_itt);
+            vertex target = mds_context.get_target_edge(*edges_itt);
+            edge_lines.append("e ").append(first + static_cast<long long>(source) + 1).append(' ').append(first + static_cast<long long>(target) + 1).append('\n');
+            num_edges++;
+        }
+
+        num_vertices += component_vertices;
+        cnt_sel += mds_context.cnt_sel;
+        cnt_dom += mds_context.cnt_dom;
+        cnt_excl += mds_context.cnt_excl;
+        cnt_ign += mds_context.cnt_ign;
+        cnt_rem += mds_context.cnt_rem;
+        num_nodes += mds_context.num_nodes;
+    }
+
+    void KERNEL_WRITER::write(int num_original_vertices, const std::string& instance_path, const std::string& kernel_path) const {
+        OUTPUT_BUFFER buffer;
+        buffer.reserve(256 + instance_path.size() + vertex_lines.size() + edge_lines.size());
+        buffer.append("c mds kernel\n");
+        buffer.append("k ").append(static_cast<long long>(KERNEL_VERSION)).append(' ').append(static_cast<long long>(num_vertices));
+        buffer.append(' ').append(num_edges).append(' ').append(static_cast<long long>(num_original_vertices)).append('\n');
+        buffer.append("i ").append(instance_path == "-" ? instance_path : std::filesystem::absolute(instance_path).string()).append('\n');
+        buffer.append("n ").append(static_cast<long long>(cnt_sel)).append(' ').append(static_cast<long long>(cnt_dom));
+        buffer.append(' ').append(static_cast<long long>(cnt_excl)).append(' ').append(static_cast<long long>(cnt_ign));
+        buffer.append(' ').append(static_cast<long long>(cnt_rem)).append(' ').append(static_cast<long long>(num_nodes)).append('\n');
+        buffer.append(vertex_lines);
+        buffer.append(edge_lines);
+        if (!OUTPUT_SINK::write_file(kernel_path, buffer)) {
+            throw std::runtime_error("Failed to write kernel file");
+        }
+    }
+
+    kernel_instance load_kernel(const std::string& kernel_path) {
+        std::ifstream f(kernel_path);
+        if (f.fail()) {
+            throw std::invalid_argument("Failed to open file");
+        }
+        int version = 0;
+        int num_vertices = -1;
+        long long num_edges = 0;
+        int num_original_vertices = 0;
+        std::string instance_path;
+        int cnt_sel = 0, cnt_dom = 0, cnt_excl = 0, cnt_ign = 0, cnt_rem = 0, num_nodes = 0;
+        std::vector<int> kernelToOriginal;
+        std::vector<int> flags;
+        std::vector<vertex_counters> counters;
+        std::vector<std::pair<int, int>> edges;
+
+        //every count of the header is checked against the lines, and every id against its range, before anything is indexed.
+        bool has_header = false;
+        bool has_counts = false;
+        long long line_number = 0;
+        auto malformed = [&line_number](const std::string& reason) {
+            return std::invalid_argument("Malformed kernel (entry " + std::to_string(line_number) + "): " + reason);
+        };
+        for (std::string type; f >> type;) {
+            line_number++;
+            if (type == "c") {
+                std::getline(f, type);
+                continue;
+            }
+            if (type != "k" && !has_header) {
+                throw malformed("the k line has to come first");
+            }
+            if (type == "k") {
+                if (has_header) {
+                    throw malformed("second k line");
+                }
+                has_header = true;
+                f >> version >> num_vertices >> num_edges >> num_original_vertices;
+                if (f.fail()) {
+                    throw malformed("k line");
+                }
+                if (version != KERNEL_VERSION) {
+                    throw std::invalid_argument("Unsupported kernel version");
+                }
+                if (num_vertices < 0 || num_edges < 0 || num_original_vertices < 0) {
+                    throw malformed("negative count in the k line");
+                }
+                kernelToOriginal.reserve(num_vertices);
+                flags.reserve(num_vertices);
+                counters.reserve(num_vertices);
+            } else if (type == "i") {
+                f >> std::ws;
+                std::getline(f, instance_path);
+            } else if (type == "n") {
+                f >> cnt_sel >> cnt_dom >> cnt_excl >> cnt_ign >> cnt_rem >> num_nodes;
+                if (f.fail()) {
+                    throw malformed("n line");
+                }
+                for (int count : { cnt_sel, cnt_dom, cnt_excl, cnt_ign, cnt_rem, num_nodes }) {
+                    if (count < 0 || count > num_vertices) {
+                        throw malformed("count in the n line is not in 0.." + std::to_string(num_vertices));
+                    }
+                }
+                has_counts = true;
+            } else if (type == "v") {
+                int original, flag, d, nd, x;
+                f >> original >> flag >> d >> nd >> x;
+                if (f.fail()) {
+                    throw malformed("v line");
+                }
+                if (kernelToOriginal.size() == static_cast<std::size_t>(num_vertices)) {
+                    throw malformed("more v lines than the " + std::to_string(num_vertices) + " vertices of the k line");
+                }
+                if (original < 0 || original > num_original_vertices) {
+                    throw malformed("original vertex " + std::to_string(original) + " is not in 0.." + std::to_string(num_original_vertices));
+                }
+                if (flag < 0 || flag > (KERNEL_SELECTED | KERNEL_DOMINATED | KERNEL_REMOVED | KERNEL_EXCLUDED | KERNEL_IGNORED)) {
+                    throw malformed("unknown flags " + std::to_string(flag));
+                }
+                if (d < 0 || nd < 0 || x < 0) {
+                    throw malformed("negative counter");
+                }
+                kernelToOriginal.push_back(original - 1);
+                flags.push_back(flag);
+                counters.push_back(vertex_counters{ d, nd, x });
+            } else if (type == "e") {
+                int u, v;
+                f >> u >> v;
+                if (f.fail()) {
+                    throw malformed("e line");
+                }
+                if (edges.size() == static_cast<std::size_t>(num_edges)) {
+                    throw malformed("more e lines than the " + std::to_string(num_edges) + " edges of the k line");
+                }
+                if (u < 1 || u > num_vertices || v < 1 || v > num_vertices) {
+                    throw malformed("edge vertex is not in 1.." + std::to_string(num_vertices));
+                }
+                edges.push_back({ u - 1, v - 1 });
+            } else {
+                throw malformed("unknown line type " + type);
+            }
+        }
+        if (!has_header || !has_counts) {
+            throw std::invalid_argument("Incomplete kernel file: the k or n line is missing");
+        }
+        if (kernelToOriginal.size() != static_cast<std::size_t>(num_vertices)) {
+            throw std::invalid_argument("Incomplete kernel file: " + std::to_string(kernelToOriginal.size()) + " of " + std::to_string(num_vertices) + " v lines");
+        }
+        if (edges.size() != static_cast<std::size_t>(num_edges)) {
+            throw std::invalid_argument("Incomplete kernel file: " + std::to_string(edges.size()) + " of " + std::to_string(num_edges) + " e lines");
+        }
+
+        adjacencyListBoost g(num_vertices);
+        for (auto& [u, v] : edges) {
+            boost::add_edge(u, v, g);
+        }
+
+        kernel_instance kernel;
+        kernel.mds_context = std::make_unique<MDS_CONTEXT>(g);
+        MDS_CONTEXT& mds_context = *kernel.mds_context;
+        for (int v = 0; v < num_vertices; ++v) {
+            if (flags[v] & KERNEL_SELECTED) mds_context.set_state(v, STATE_SELECTED);
+            if (flags[v] & KERNEL_DOMINATED) mds_context.set_state(v, STATE_DOMINATED);
+            if (flags[v] & KERNEL_REMOVED) mds_context.set_state(v, STATE_REMOVED);
+            if (flags[v] & KERNEL_EXCLUDED) mds_context.set_state(v, STATE_EXCLUDED);
+            if (flags[v] & KERNEL_IGNORED) mds_context.set_state(v, STATE_IGNORED);
+        }
+        mds_context.counters = std::move(counters);
+        mds_context.cnt_sel = cnt_sel;
+        mds_context.cnt_dom = cnt_dom;
+        mds_context.cnt_excl = cnt_excl;
+        mds_context.cnt_ign = cnt_ign;
+        mds_context.cnt_rem = cnt_rem;
+        mds_context.num_nodes = num_nodes;
+        kernel.kernelToOriginal = std::move(kernelToOriginal);
+        kernel.num_original_vertices = num_original_vertices;
+        kernel.instance_path = std::move(instance_path);
+        return kernel;
+    }
+
+    std::vector<int> lift_solution(const kernel_instance& kernel, const std::vector<int>& kernel_solution) {
+        std::vector<int> solution;
+        solution.reserve(kernel_solution.size());
+        for (int v : kernel_solution) {
+            if (v < 0 || static_cast<std::size_t>(v) >= kernel.kernelToOriginal.size()) {
+                throw std::runtime_error("Kernel vertex out of range in solution");
+            }
+            int original = kernel.kernelToOriginal[v];
+            //selector vertices are always excluded, they can not be part of a solution.
+            if (original < 0) {
+                throw std::runtime_error("Gadget vertex in solution");
+            }
+            solution.push_back(original + 1);
+        }
+        return solution;
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "context.h"
+#include "../util/output_sink.h"
+
+//Round-trippable dump of a reduced MDS_CONTEXT, so the reduction rules only have to run once per instance.
+//format (all vertex ids 1 indexed):
+//  c <comment>
+//  k <version> <num_vertices> <num_edges> <num_original_vertices>
+//  i <path of the instance the kernel was exported from, absolute, - for stdin>
+//  n <cnt_sel> <cnt_dom> <cnt_excl> <cnt_ign> <cnt_rem> <num_nodes>
+//  v <original id, 0 for gadget vertices> <flags> <c_d> <c_nd> <c_x>   (one line per vertex, in order)
+//  e <u> <v>
+namespace parse {
+    //2: the edges are written in the order of the tombstoned adjacency of DYNAMIC_GRAPH.
+    //3: the path of the instance is stored, so a lifted solution can be verified against it.
+    const int KERNEL_VERSION = 3;
+
+    enum kernel_flag {
+        KERNEL_SELECTED = 1,
+        KERNEL_DOMINATED = 2,
+        KERNEL_REMOVED = 4,
+        KERNEL_EXCLUDED = 8,
+        KERNEL_IGNORED = 16
+    };
+
+    struct kernel_instance {
+        std::unique_ptr<MDS_CONTEXT> mds_context;
+        //kernelToOriginal[v] is the 0 indexed vertex of the original instance, -1 for the gadget (selector) vertices
+        //added by the reduction rules.
+        std::vector<int> kernelToOriginal;
+        int num_original_vertices;
+        std::string instance_path;
+    };
+
+    //collects the reduced components of an instance and writes them as one kernel, the vertices of a component get
+    //consecutive kernel ids in the order the components are added. a component can be released right after add.
+    class KERNEL_WRITER {
+    public:
+        //kernelToOriginal[v] is the 0 indexed vertex of the instance for vertex v of mds_context, -1 for gadget vertices.
+        void add(MDS_CONTEXT& mds_context, const std::vector<int>& kernelToOriginal);
+
+        void write(int num_original_vertices, const std::string& instance_path, const std::string& kernel_path) const;
+
+    private:
+        OUTPUT_BUFFER vertex_lines;
+        OUTPUT_BUFFER edge_lines;
+        int num_vertices = 0;
+        long long num_edges = 0;
+        int cnt_sel = 0, cnt_dom = 0, cnt_excl = 0, cnt_ign = 0, cnt_rem = 0, num_nodes = 0;
+    };
+
+    kernel_instance load_kernel(const std::string& kernel_path);
+
+    //translates kernel vertices (0 indexed) to original vertices (1 indexed, like output_solution expects).
+    std::vector<int> lift_solution(const kernel_instance& kernel, const std::vector<int>& kernel_solution);
+}
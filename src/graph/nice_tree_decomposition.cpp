@@ -6,10 +6,12 @@
 #include <queue>
 #include <htd/AdaptiveWidthMinimizingTreeDecompositionAlgorithm.hpp>
 #include <utility>
+#include <algorithm>
+#include <iterator>
 
-NICE_TREE_DECOMPOSITION::NICE_TREE_DECOMPOSITION(adjacencyListBoost& reduced_graph, const htd::ITreeDecomposition* decomposition) {
+NICE_TREE_DECOMPOSITION::NICE_TREE_DECOMPOSITION(const CSR_GRAPH& reduced_graph, const htd::ITreeDecomposition* decomposition) {
     //decomposition in 1 indexed, and my structure is 0 indexed.
-    const int edge_cnt = boost::num_edges(reduced_graph);
+    const int edge_cnt = reduced_graph.num_edges;
     const int vertex_cnt = decomposition->vertexCount();
 
     //initialize graph.
@@ -109,6 +111,143 @@ NICE_TREE_DECOMPOSITION::NICE_TREE_DECOMPOSITION(adjacencyListBoost& reduced_gra
     introduce_all_edges_smart(reduced_graph);
 }
 
+NICE_TREE_DECOMPOSITION::NICE_TREE_DECOMPOSITION(std::vector<std::vector<int>> bags, std::vector<std::pair<int, int>> tree_edges, const CSR_GRAPH& g) {
+    const int bag_cnt = bags.size();
+    const int vertex_cnt = g.num_vertices;
+    if (bag_cnt == 0 || tree_edges.size() != bag_cnt - 1) {
+        throw std::invalid_argument("The tree decomposition is not a tree.");
+    }
+
+    //bags have to be sorted, the treewidth solver finds vertices with a binary search.
+    treewidth = 0;
+    std::vector<bool> covered(vertex_cnt, false);
+    for (auto& bag : bags) {
+        std::sort(bag.begin(), bag.end());
+        bag.erase(std::unique(bag.begin(), bag.end()), bag.end());
+        for (int v : bag) {
+            if (v < 0 || v >= vertex_cnt) {
+                throw std::invalid_argument("Bag contains a vertex which is not in the graph.");
+            }
+            covered[v] = true;
+        }
+        treewidth = std::max(treewidth, static_cast<int>(bag.size()) - 1);
+    }
+    if (std::find(covered.begin(), covered.end(), false) != covered.end()) {
+        throw std::invalid_argument("Not every vertex is in a bag.");
+    }
+
+    std::vector<std::vector<int>> tree(bag_cnt);
+    for (auto& [a, b] : tree_edges) {
+        if (a < 0 || a >= bag_cnt || b < 0 || b >= bag_cnt) {
+            throw std::invalid_argument("Tree edge between unknown bags.");
+        }
+        tree[a].push_back(b);
+        tree[b].push_back(a);
+    }
+
+    //order the bags from the root (bag 0) downwards, without recursion (decompositions can be very deep).
+    std::vector<int> parent(bag_cnt, -1);
+    std::vector<bool> visited(bag_cnt, false);
+    std::vector<int> order;
+    order.reserve(bag_cnt);
+    std::vector<int> stack = {0};
+    visited[0] = true;
+    while (!stack.empty()) {
+        int current = stack.back();
+        stack.pop_back();
+        order.push_back(current);
+        for (int child : tree[current]) {
+            if (!visited[child]) {
+                visited[child] = true;
+                parent[child] = current;
+                stack.push_back(child);
+            }
+        }
+    }
+    if (order.size() != bag_cnt) {
+        throw std::invalid_argument("The tree decomposition is not connected.");
+    }
+
+    //running intersection: the bags containing v are a connected subtree, so exactly one of them (the top of the subtree)
+    //has no parent containing v. otherwise the DP would combine states of v which are unrelated.
+    std::vector<int> subtree_tops(vertex_cnt, 0);
+    for (int t = 0; t < bag_cnt; ++t) {
+        for (int v : bags[t]) {
+            if (parent[t] == -1 || !std::binary_search(bags[parent[t]].begin(), bags[parent[t]].end(), v)) {
+                if (++subtree_tops[v] > 1) {
+                    throw std::invalid_argument("The bags containing a vertex are not connected.");
+                }
+            }
+        }
+    }
+
+    nice_bags.reserve(4 * bag_cnt);
+    std::vector<std::vector<uint>> sorted_bags(bag_cnt);
+    for (int i = 0; i < bag_cnt; ++i) {
+        sorted_bags[i].assign(bags[i].begin(), bags[i].end());
+    }
+
+    //bottom up: top[t] is the nice bag (with the content of bag t) on top of the unfolded subtree of t.
+    std::vector<int> top(bag_cnt, -1);
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        const int current = *it;
+        std::vector<int> unfolded_children;
+        for (int child : tree[current]) {
+            if (child != parent[current]) {
+                unfolded_children.push_back(unfold_parent_vertex(top[child], sorted_bags[current], sorted_bags[child]));
+            }
+        }
+        if (unfolded_children.empty()) {
+            top[current] = unfold_leaf_vertex(sorted_bags[current]);
+            continue;
+        }
+        //more than one child, combine them with join bags (every join has exactly two children).
+        int joined = unfolded_children[0];
+        for (int k = 1; k < unfolded_children.size(); ++k) {
+            joined = add_nice_bag(nice_bag(operation_enum::JOIN, sorted_bags[current]), {joined, unfolded_children[k]});
+        }
+        top[current] = joined;
+    }
+    root_vertex = top[0];
+    this->bags = std::move(bags);
+    introduce_all_edges_smart(g);
+}
+
+int NICE_TREE_DECOMPOSITION::add_nice_bag(nice_bag bag, const std::vector<int>& children) {
+    const int index = nice_bags.size();
+    nice_bags.push_back(std::move(bag));
+    boost::add_vertex(graph_nice_tree_decomposition);
+    for (int child : children) {
+        boost::add_edge(index, child, graph_nice_tree_decomposition);
+    }
+    return index;
+}
+
+//from the bag of the child to the bag of the parent: first forget, then introduce (one vertex per bag).
+int NICE_TREE_DECOMPOSITION::unfold_parent_vertex(int child, const std::vector<uint>& bag_parent, const std::vector<uint>& bag_child) {
+    std::vector<uint> forget_vertices;
+    std::vector<uint> introduce_vertices;
+    std::set_difference(bag_child.begin(), bag_child.end(), bag_parent.begin(), bag_parent.end(), std::back_inserter(forget_vertices));
+    std::set_difference(bag_parent.begin(), bag_parent.end(), bag_child.begin(), bag_child.end(), std::back_inserter(introduce_vertices));
+
+    std::vector<uint> bag = bag_child;
+    for (uint v : forget_vertices) {
+        bag.erase(std::lower_bound(bag.begin(), bag.end(), v));
+        child = add_nice_bag(nice_bag(operation_enum::FORGET, v, bag), {child});
+    }
+    for (uint v : introduce_vertices) {
+        bag.insert(std::lower_bound(bag.begin(), bag.end(), v), v);
+        child = add_nice_bag(nice_bag(operation_enum::INTRODUCE, v, bag), {child});
+    }
+    return child;
+}
+
+//empty leaf, followed by introducing every vertex of the bag.
+int NICE_TREE_DECOMPOSITION::unfold_leaf_vertex(const std::vector<uint>& bag) {
+    int leaf = add_nice_bag(nice_bag(operation_enum::LEAF, std::vector<uint>()), {});
+    return unfold_parent_vertex(leaf, bag, std::vector<uint>());
+}
+
 //helper function.
 std::vector<std::pair<int, int>> find_all_pairs(const std::vector<uint>& bag) {
     std::vector<std::pair<int, int>> res;
@@ -141,15 +280,31 @@ std::vector<int> which_edges_must_be_introduced(const adjacencyListBoost& origin
 	return must_introduce;
 }
 
+std::vector<int> which_edges_must_be_introduced(const CSR_GRAPH& original_graph, const std::vector<bool>& introduced, std::vector<uint>& bag_child, int forget_vertex) {
+	std::vector<int>must_introduce;
+	for (int end_point : bag_child) {
+		if (end_point != forget_vertex) {
+			long long edge = original_graph.find_edge(std::min(forget_vertex, end_point), std::max(forget_vertex, end_point));
+			if (edge != -1 && !introduced[edge]) {
+				must_introduce.push_back(end_point);
+			}
+		}
+	}
+	return must_introduce;
+}
+
 //we remove the edges from the original graph which are already introduced.
-void NICE_TREE_DECOMPOSITION::introduce_all_edges_smart(adjacencyListBoost& original_graph)
+void NICE_TREE_DECOMPOSITION::introduce_all_edges_smart(const CSR_GRAPH& original_graph)
 {
+    //the graph is read only, introduced edges are marked instead of removed.
+    std::vector<bool> introduced(original_graph.num_neighbors(), false);
     //All vertices in the root_bag, will never be forgotten. So either need to be introduced above the root node or the smallest bag both enpoints are present in.
     std::vector<std::pair<int,int>> pairs = find_all_pairs(nice_bags[root_vertex].bag);
     for (auto& [source, target] : pairs) {
-        if (auto [edge, exists] = boost::edge(source, target, original_graph); exists) {
+        long long edge = original_graph.find_edge(std::min(source, target), std::max(source, target));
+        if (edge != -1 && !introduced[edge]) {
             //for each edge which actually exists, take a walker.
-            int _ = introduce_edge_smart(source, target, -1, root_vertex,original_graph);
+            int _ = introduce_edge_smart(source, target, -1, root_vertex, original_graph, introduced);
         }
     }
     //Introduce all other vertices.
@@ -169,10 +324,10 @@ void NICE_TREE_DECOMPOSITION::introduce_all_edges_smart(adjacencyListBoost& orig
         //If the parent vertex is a forget node, all edges which share an endpoint with the forgotten node, need to be introduced before this.
         if (std::holds_alternative<operation_forget>(nice_bags[curr_parent].op)){
             auto & op = std::get<operation_forget>(nice_bags[curr_parent].op);
-            std::vector<int> introduce = which_edges_must_be_introduced(original_graph,nice_bags[curr_child].bag, op.vertex);
+            std::vector<int> introduce = which_edges_must_be_introduced(original_graph, introduced, nice_bags[curr_child].bag, op.vertex);
 
             for (auto into : introduce) {
-                curr_parent = introduce_edge_smart(op.vertex, into, curr_parent, curr_child, original_graph);
+                curr_parent = introduce_edge_smart(op.vertex, into, curr_parent, curr_child, original_graph, introduced);
             }
         }
         //fill queue with children of current node.
@@ -181,13 +336,13 @@ void NICE_TREE_DECOMPOSITION::introduce_all_edges_smart(adjacencyListBoost& orig
             q.emplace(new_child, curr_child);
         }
     }
-    if (boost::num_edges(original_graph) != 0) {
+    if (std::count(introduced.begin(), introduced.end(), true) != original_graph.num_edges) {
         throw std::runtime_error("Not every edge has been introduced.");
     }
 }
 
 //helper function.
-int NICE_TREE_DECOMPOSITION::introduce_edge_smart(int source, int target, int parent, int child, adjacencyListBoost& original_graph){
+int NICE_TREE_DECOMPOSITION::introduce_edge_smart(int source, int target, int parent, int child, const CSR_GRAPH& original_graph, std::vector<bool>& introduced){
     int smallest_bag_index = child;
     int smallest_bag_size = nice_bags[child].bag.size();
     int smallest_bag_parent = parent;
@@ -221,7 +376,7 @@ int NICE_TREE_DECOMPOSITION::introduce_edge_smart(int source, int target, int pa
         }
     }
     //keep track of already introduced vertices.
-    boost::remove_edge(source,target, original_graph);
+    introduced[original_graph.find_edge(std::min(source, target), std::max(source, target))] = true;
 
     //Smallest bag is the current_root node.
     if (smallest_bag_parent == -1) {
@@ -9,6 +9,8 @@
 #include <queue>
 #include <htd/ITreeDecomposition.hpp>
 
+#include "csr_graph.h"
+
 typedef boost::adjacency_list<
     boost::vecS,                                  // Param:OutEdgeList (container used for edge-list (vector))
     boost::vecS,                                  // Param:VertexList (container used for vertex List (vector))
@@ -98,21 +100,27 @@ public:
 
     int root_vertex;
 
-    explicit NICE_TREE_DECOMPOSITION(adjacencyListBoost& reduced_graph, const htd::ITreeDecomposition* decomposition);
+    explicit NICE_TREE_DECOMPOSITION(const CSR_GRAPH& reduced_graph, const htd::ITreeDecomposition* decomposition);
+
+    //Build from a precomputed (not nice) tree decomposition, e.g. a PACE .td file.
+    //bags contain 0 indexed vertices of g, tree_edges connect 0 indexed bags. bag 0 becomes the root.
+    //throws std::invalid_argument if it is not a tree decomposition of g.
+    NICE_TREE_DECOMPOSITION(std::vector<std::vector<int>> bags, std::vector<std::pair<int, int>> tree_edges, const CSR_GRAPH& g);
 
-    NICE_TREE_DECOMPOSITION(std::vector<std::vector<int>> bags, adjacencyListBoost g);
+    int add_nice_bag(nice_bag bag, const std::vector<int>& children);
 
-    int introduce_edge_smart(int source, int target, int parent, int child, adjacencyListBoost& original_graph);
+    //introduced[find_edge(min, max)] marks the edges of original_graph which already have an introduce edge bag.
+    int introduce_edge_smart(int source, int target, int parent, int child, const CSR_GRAPH& original_graph, std::vector<bool>& introduced);
 
-    void introduce_all_edges_smart(adjacencyListBoost& original_graph);
+    void introduce_all_edges_smart(const CSR_GRAPH& original_graph);
 
     void introduce_all_edges(adjacencyListBoost& original_graph);
 
     void traverse_tree_decomposition(int parent_index, vertex v);
 
     // int select_root_bag();
-    //
-    // void unfold_parent_vertex(int parent, int child, const std::vector<int>& bag_parent, const std::vector<int>& bag_child);
-    //
-    // void unfold_leaf_vertex(int vertex);
+
+    int unfold_parent_vertex(int child, const std::vector<uint>& bag_parent, const std::vector<uint>& bag_child);
+
+    int unfold_leaf_vertex(const std::vector<uint>& bag);
 };
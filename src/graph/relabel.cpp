@@ -0,0 +1,137 @@
+#include "relabel.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace relabel {
+    std::vector<int> compute_order(const CSR_GRAPH& graph, strategy_relabel strategy) {
+        switch (strategy) {
+        case RELABEL_RCM:
+            return order_rcm(graph);
+        case RELABEL_BFS:
+            return order_bfs(graph);
+        case RELABEL_DEGREE:
+            return order_degree(graph);
+        default: {
+            std::vector<int> identity(graph.num_vertices);
+            for (int v = 0; v < graph.num_vertices; ++v) {
+                identity[v] = v;
+            }
+            return identity;
+        }
+        }
+    }
+
+    //BFS over all components, every component starts at its first unvisited vertex in start_order.
+    static std::vector<int> bfs_order(const CSR_GRAPH& graph, const std::vector<int>& start_order, bool by_degree) {
+        std::vector<int> order;
+        order.reserve(graph.num_vertices);
+        std::vector<bool> visited(graph.num_vertices, false);
+        std::vector<int> neighbors;
+        for (int s : start_order) {
+            if (visited[s]) {
+                continue;
+            }
+            visited[s] = true;
+            //order is the queue, head is the next vertex to expand.
+            std::size_t head = order.size();
+            order.push_back(s);
+            for (; head < order.size(); ++head) {
+                auto [neigh_itt, neigh_itt_end] = graph.get_neighborhood(order[head]);
+                neighbors.clear();
+                for (; neigh_itt != neigh_itt_end; ++neigh_itt) {
+                    if (!visited[*neigh_itt]) {
+                        visited[*neigh_itt] = true;
+                        neighbors.push_back(*neigh_itt);
+                    }
+                }
+                if (by_degree) {
+                    std::stable_sort(neighbors.begin(), neighbors.end(), [&graph](int a, int b) {
+                        return graph.get_degree(a) < graph.get_degree(b);
+                    });
+                }
+                order.insert(order.end(), neighbors.begin(), neighbors.end());
+            }
+        }
+        return order;
+    }
+
+    std::vector<int> order_rcm(const CSR_GRAPH& graph) {
+        //every component starts at (one of) its minimum degree vertices.
+        std::vector<int> start_order(graph.num_vertices);
+        for (int v = 0; v < graph.num_vertices; ++v) {
+            start_order[v] = v;
+        }
+        std::stable_sort(start_order.begin(), start_order.end(), [&graph](int a, int b) {
+            return graph.get_degree(a) < graph.get_degree(b);
+        });
+        std::vector<int> order = bfs_order(graph, start_order, true);
+        std::reverse(order.begin(), order.end());
+        return order;
+    }
+
+    std::vector<int> order_bfs(const CSR_GRAPH& graph) {
+        std::vector<int> start_order(graph.num_vertices);
+        for (int v = 0; v < graph.num_vertices; ++v) {
+            start_order[v] = v;
+        }
+        return bfs_order(graph, start_order, false);
+    }
+
+    std::vector<int> order_degree(const CSR_GRAPH& graph) {
+        std::vector<int> order(graph.num_vertices);
+        for (int v = 0; v < graph.num_vertices; ++v) {
+            order[v] = v;
+        }
+        std::stable_sort(order.begin(), order.end(), [&graph](int a, int b) {
+            return graph.get_degree(a) > graph.get_degree(b);
+        });
+        return order;
+    }
+
+    CSR_GRAPH apply_order(const CSR_GRAPH& graph, const std::vector<int>& newToOld) {
+        const int n = graph.num_vertices;
+        if (static_cast<int>(newToOld.size()) != n) {
+            throw std::invalid_argument("Order is not a permutation of the vertices");
+        }
+        std::vector<int> oldToNew(n, -1);
+        for (int v = 0; v < n; ++v) {
+            if (newToOld[v] < 0 || newToOld[v] >= n || oldToNew[newToOld[v]] != -1) {
+                throw std::invalid_argument("Order is not a permutation of the vertices");
+            }
+            oldToNew[newToOld[v]] = v;
+        }
+
+        std::vector<std::uint64_t> offsets(n + 1, 0);
+        for (int v = 0; v < n; ++v) {
+            offsets[v + 1] = offsets[v] + graph.get_degree(newToOld[v]);
+        }
+        std::vector<std::uint32_t> neighbors(offsets[n]);
+        for (int v = 0; v < n; ++v) {
+            auto [neigh_itt, neigh_itt_end] = graph.get_neighborhood(newToOld[v]);
+            std::uint32_t* out = neighbors.data() + offsets[v];
+            for (; neigh_itt != neigh_itt_end; ++neigh_itt) {
+                *out++ = oldToNew[*neigh_itt];
+            }
+        }
+        CSR_GRAPH relabeled(n, graph.num_edges, std::move(offsets), std::move(neighbors));
+        relabeled.sort_neighborhoods();
+        return relabeled;
+    }
+
+    strategy_relabel string_to_strategy_relabel(const std::string& str) {
+        if (str == "none" || str == "non") {
+            return RELABEL_NON;
+        }
+        if (str == "rcm" || str == "RCM") {
+            return RELABEL_RCM;
+        }
+        if (str == "bfs" || str == "BFS") {
+            return RELABEL_BFS;
+        }
+        if (str == "degree" || str == "DEGREE") {
+            return RELABEL_DEGREE;
+        }
+        throw std::invalid_argument("not a viable relabel strategy");
+    }
+}
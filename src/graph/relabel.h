@@ -0,0 +1,26 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "csr_graph.h"
+#include "../util/logger.h"
+
+//Renumbers the vertices of an instance so that neighbors get nearby ids (fewer cache misses in the reductions).
+namespace relabel {
+    //newToOld[new id] = id in the instance, a permutation of all vertices.
+    std::vector<int> compute_order(const CSR_GRAPH& graph, strategy_relabel strategy);
+
+    //reverse Cuthill-McKee: BFS per component from a minimum degree vertex, neighbors by increasing degree, reversed.
+    std::vector<int> order_rcm(const CSR_GRAPH& graph);
+
+    //BFS per component, in the order of the neighborhoods.
+    std::vector<int> order_bfs(const CSR_GRAPH& graph);
+
+    //decreasing degree, ties by id.
+    std::vector<int> order_degree(const CSR_GRAPH& graph);
+
+    //the relabeled graph (sorted neighborhoods), vertex new is vertex newToOld[new] of graph.
+    CSR_GRAPH apply_order(const CSR_GRAPH& graph, const std::vector<int>& newToOld);
+
+    strategy_relabel string_to_strategy_relabel(const std::string& str);
+}
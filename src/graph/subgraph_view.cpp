@@ -0,0 +1,131 @@
+#include "subgraph_view.h"
+
+SUBGRAPH_VIEW::SUBGRAPH_VIEW() : parent(nullptr), edge_begin(0), edge_end(0) {}
+
+std::vector<SUBGRAPH_VIEW> SUBGRAPH_VIEW::split_components(const DYNAMIC_GRAPH& parent, const std::vector<bool>& keep) {
+    const int n = parent.num_vertices();
+    std::vector<int> view_of(n, -1);
+    std::vector<int> stack;
+    int num_views = 0;
+    for (int s = 0; s < n; ++s) {
+        if (!keep[s] || view_of[s] != -1) {
+            continue;
+        }
+        view_of[s] = num_views;
+        stack.push_back(s);
+        while (!stack.empty()) {
+            const int u = stack.back();
+            stack.pop_back();
+            for (auto [neigh_itt, neigh_itt_end] = parent.neighbors(u); neigh_itt != neigh_itt_end; ++neigh_itt) {
+                const int w = static_cast<int>(*neigh_itt);
+                if (keep[w] && view_of[w] == -1) {
+                    view_of[w] = num_views;
+                    stack.push_back(w);
+                }
+            }
+        }
+        num_views++;
+    }
+    return build(parent, view_of, num_views);
+}
+
+SUBGRAPH_VIEW SUBGRAPH_VIEW::induced(const DYNAMIC_GRAPH& parent, const std::vector<bool>& keep) {
+    std::vector<int> view_of(parent.num_vertices(), -1);
+    for (int v = 0; v < parent.num_vertices(); ++v) {
+        if (keep[v]) {
+            view_of[v] = 0;
+        }
+    }
+    return std::move(build(parent, view_of, 1)[0]);
+}
+
+std::vector<SUBGRAPH_VIEW> SUBGRAPH_VIEW::build(const DYNAMIC_GRAPH& parent, const std::vector<int>& view_of, int num_views) {
+    auto index = std::make_shared<split_index>();
+    std::vector<SUBGRAPH_VIEW> views(num_views);
+    index->global_to_local.assign(parent.num_vertices(), -1);
+    for (int v = 0; v < parent.num_vertices(); ++v) {
+        if (view_of[v] >= 0) {
+            index->global_to_local[v] = static_cast<int>(views[view_of[v]].vertices.size());
+            views[view_of[v]].vertices.push_back(v);
+        }
+    }
+
+    //counting sort of the live edges on their view, the edge ids stay ascending within a view.
+    std::vector<int> edge_offset(num_views + 1, 0);
+    for (auto [edge_it, edge_it_end] = parent.edges(); edge_it != edge_it_end; ++edge_it) {
+        const DYNAMIC_GRAPH::edge_endpoints e = parent.endpoints(*edge_it);
+        if (view_of[e.source] >= 0 && view_of[e.target] >= 0) {
+            edge_offset[view_of[e.source] + 1]++;
+        }
+    }
+    for (int i = 0; i < num_views; ++i) {
+        edge_offset[i + 1] += edge_offset[i];
+    }
+    index->edge_ids.resize(edge_offset[num_views]);
+    std::vector<int> position(edge_offset.begin(), edge_offset.end() - 1);
+    for (auto [edge_it, edge_it_end] = parent.edges(); edge_it != edge_it_end; ++edge_it) {
+        const DYNAMIC_GRAPH::edge_endpoints e = parent.endpoints(*edge_it);
+        if (view_of[e.source] >= 0 && view_of[e.target] >= 0) {
+            index->edge_ids[position[view_of[e.source]]++] = *edge_it;
+        }
+    }
+
+    for (int i = 0; i < num_views; ++i) {
+        views[i].parent = &parent;
+        views[i].index = index;
+        views[i].edge_begin = edge_offset[i];
+        views[i].edge_end = edge_offset[i + 1];
+    }
+    return views;
+}
+
+int SUBGRAPH_VIEW::num_vertices() const {
+    return static_cast<int>(vertices.size());
+}
+
+int SUBGRAPH_VIEW::num_edges() const {
+    return edge_end - edge_begin;
+}
+
+int SUBGRAPH_VIEW::global(int v) const {
+    return vertices[v];
+}
+
+const std::vector<int>& SUBGRAPH_VIEW::local_to_global() const {
+    return vertices;
+}
+
+std::pair<SUBGRAPH_VIEW::neighbor_iterator, SUBGRAPH_VIEW::neighbor_iterator> SUBGRAPH_VIEW::neighbors(int v) const {
+    auto [neigh_itt, neigh_itt_end] = parent->neighbors(vertices[v]);
+    const std::vector<int>* global_to_local = &index->global_to_local;
+    return std::make_pair(neighbor_iterator(neigh_itt, neigh_itt_end, global_to_local), neighbor_iterator(neigh_itt_end, neigh_itt_end, global_to_local));
+}
+
+DYNAMIC_GRAPH::edge_endpoints SUBGRAPH_VIEW::edge(int i) const {
+    const DYNAMIC_GRAPH::edge_endpoints e = parent->endpoints(index->edge_ids[edge_begin + i]);
+    return { static_cast<std::uint32_t>(index->global_to_local[e.source]), static_cast<std::uint32_t>(index->global_to_local[e.target]) };
+}
+
+CSR_GRAPH SUBGRAPH_VIEW::to_csr() const {
+    const int n = num_vertices();
+    std::vector<std::uint64_t> offsets(n + 1, 0);
+    for (int v = 0; v < n; ++v) {
+        std::uint64_t degree = 0;
+        for (auto [neigh_itt, neigh_itt_end] = neighbors(v); neigh_itt != neigh_itt_end; ++neigh_itt) {
+            degree++;
+        }
+        offsets[v + 1] = offsets[v] + degree;
+    }
+    std::vector<std::uint32_t> neighbor_list(offsets[n]);
+    for (int v = 0; v < n; ++v) {
+        std::uint64_t position = offsets[v];
+        for (auto [neigh_itt, neigh_itt_end] = neighbors(v); neigh_itt != neigh_itt_end; ++neigh_itt) {
+            neighbor_list[position++] = static_cast<std::uint32_t>(*neigh_itt);
+        }
+    }
+    CSR_GRAPH csr(n, num_edges(), std::move(offsets), std::move(neighbor_list));
+    csr.sort_neighborhoods();
+    long long duplicates, self_loops;
+    csr.remove_duplicate_edges(duplicates, self_loops);
+    return csr;
+}
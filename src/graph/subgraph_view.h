@@ -0,0 +1,99 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.h"
+#include "dynamic_graph.h"
+
+//Induced subgraph of a DYNAMIC_GRAPH, the edges are not copied.
+//a view has its vertex list (local to global, ascending), the neighborhoods are read from the parent and filtered.
+//the views of one split share the global to local array and the edge ids of the parent (grouped by view),
+//so splitting a graph into many components allocates one vertex list per component.
+//the parent has to outlive its views and must not change (no removed edges, no compact) while they are used.
+class SUBGRAPH_VIEW {
+public:
+    //iterates the neighbors of a vertex which are in the view, as local vertices.
+    class neighbor_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = int;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const int*;
+        using reference = int;
+
+        neighbor_iterator() : global_to_local(nullptr) {}
+
+        neighbor_iterator(DYNAMIC_GRAPH::neighbor_iterator cur, DYNAMIC_GRAPH::neighbor_iterator end, const std::vector<int>* global_to_local)
+            : cur(cur), end(end), global_to_local(global_to_local) {
+            skip_outside();
+        }
+
+        int operator*() const { return (*global_to_local)[*cur]; }
+
+        neighbor_iterator& operator++() {
+            ++cur;
+            skip_outside();
+            return *this;
+        }
+
+        bool operator==(const neighbor_iterator& other) const { return cur == other.cur; }
+        bool operator!=(const neighbor_iterator& other) const { return cur != other.cur; }
+
+    private:
+        DYNAMIC_GRAPH::neighbor_iterator cur;
+        DYNAMIC_GRAPH::neighbor_iterator end;
+        const std::vector<int>* global_to_local;
+
+        //a kept neighbor of a vertex in the view is always in the same view (the views are components).
+        void skip_outside() {
+            while (cur != end && (*global_to_local)[*cur] < 0) {
+                ++cur;
+            }
+        }
+    };
+
+    SUBGRAPH_VIEW();
+
+    //one view per connected component of the subgraph induced by the vertices with keep[v].
+    //components are numbered in order of their smallest vertex (as boost::connected_components).
+    static std::vector<SUBGRAPH_VIEW> split_components(const DYNAMIC_GRAPH& parent, const std::vector<bool>& keep);
+
+    //the subgraph induced by the vertices with keep[v] as one view (it may be disconnected).
+    static SUBGRAPH_VIEW induced(const DYNAMIC_GRAPH& parent, const std::vector<bool>& keep);
+
+    int num_vertices() const;
+
+    int num_edges() const;
+
+    //vertex of the parent for local vertex v.
+    int global(int v) const;
+
+    const std::vector<int>& local_to_global() const;
+
+    std::pair<neighbor_iterator, neighbor_iterator> neighbors(int v) const;
+
+    //edge i of the view with local endpoints, the edges are in the order of the parent edge ids.
+    DYNAMIC_GRAPH::edge_endpoints edge(int i) const;
+
+    //read only copy for the solvers and htd, as parse::construct_CSR (sorted neighborhoods, no parallel edges or self loops).
+    CSR_GRAPH to_csr() const;
+
+private:
+    //shared by all views of one split.
+    struct split_index {
+        std::vector<int> global_to_local; // local vertex in its view, -1 if the vertex is in no view.
+        std::vector<int> edge_ids;        // live edges of the parent grouped by view, ascending within a view.
+    };
+
+    const DYNAMIC_GRAPH* parent;
+    std::shared_ptr<const split_index> index;
+    std::vector<int> vertices;
+    int edge_begin;
+    int edge_end;
+
+    //view_of[v] is the view of v, -1 if v is not kept.
+    static std::vector<SUBGRAPH_VIEW> build(const DYNAMIC_GRAPH& parent, const std::vector<int>& view_of, int num_views);
+};
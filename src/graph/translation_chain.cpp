@@ -0,0 +1,53 @@
+#include "translation_chain.h"
+
+#include <stdexcept>
+
+TRANSLATION_CHAIN::TRANSLATION_CHAIN() {}
+
+void TRANSLATION_CHAIN::push_layer(const index_map& layer) {
+    layers.push_back(&layer);
+}
+
+void TRANSLATION_CHAIN::pop_layer() {
+    layers.pop_back();
+}
+
+std::int32_t TRANSLATION_CHAIN::translate(std::int32_t v) const {
+    for (auto layer = layers.rbegin(); layer != layers.rend(); ++layer) {
+        if (v < 0 || v >= static_cast<std::int32_t>((*layer)->size())) {
+            return -1;
+        }
+        v = (**layer)[v];
+    }
+    return v;
+}
+
+index_map TRANSLATION_CHAIN::compose() const {
+    if (layers.empty()) {
+        return index_map();
+    }
+    //one pass per layer over a contiguous array, from the deepest level up.
+    index_map composed(*layers.back());
+    for (int k = static_cast<int>(layers.size()) - 2; k >= 0; --k) {
+        const index_map& layer = *layers[k];
+        for (std::int32_t& v : composed) {
+            v = (v < 0 || v >= static_cast<std::int32_t>(layer.size())) ? -1 : layer[v];
+        }
+    }
+    return composed;
+}
+
+std::int32_t TRANSLATION_CHAIN::solution_vertex(std::int32_t v) const {
+    const std::int32_t original = translate(v);
+    if (original < 0) {
+        throw std::runtime_error("Gadget vertex in solution");
+    }
+    return original + 1;
+}
+
+void TRANSLATION_CHAIN::lift(const std::vector<int>& vertices, std::vector<int>& solution) const {
+    solution.reserve(solution.size() + vertices.size());
+    for (int v : vertices) {
+        solution.push_back(solution_vertex(v));
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+//dense translation of the vertices of a (sub)graph to the vertices one level up, layer[v] is the vertex of v.
+typedef std::vector<std::int32_t> index_map;
+
+//Translates the vertices of a nested subgraph (component of a reduced component ...) back to the instance.
+//the chain only references its layers (e.g. SUBGRAPH_VIEW::local_to_global()), they have to outlive it.
+//a vertex outside a layer (a vertex added by a reduction rule) has no original vertex, it translates to -1.
+class TRANSLATION_CHAIN {
+public:
+    TRANSLATION_CHAIN();
+
+    //adds a deeper level, layer maps its vertices to the current deepest level.
+    void push_layer(const index_map& layer);
+
+    void pop_layer();
+
+    //vertex of the top level for vertex v of the deepest level, -1 if it has none.
+    std::int32_t translate(std::int32_t v) const;
+
+    //all layers composed into one direct map (indexed by the vertices of the deepest level).
+    index_map compose() const;
+
+    //1 indexed vertex of the instance for a vertex of a solution (of the deepest level), as in the solution file.
+    //throws for a vertex without one, the gadget vertices of the reduction rules are excluded and never in a solution.
+    std::int32_t solution_vertex(std::int32_t v) const;
+
+    //appends solution_vertex(v) for every vertex.
+    void lift(const std::vector<int>& vertices, std::vector<int>& solution) const;
+
+private:
+    std::vector<const index_map*> layers; // top level first.
+};
@@ -494,7 +494,7 @@ void TREE_DECOMPOSITION::depth_first_search(int start, int parent) {
 	}
 }
 
-void TREE_DECOMPOSITION::run_instruction_stack(std::vector<int>& dominated, std::vector<int>&excluded, std::unordered_map<int,int>& newToOldIndex) {
+void TREE_DECOMPOSITION::run_instruction_stack(std::vector<int>& dominated, std::vector<int>&excluded, const std::vector<int>& newToOldIndex) {
 
 	while (!instruction_stack.empty()) {
 		//get top instruction from the stack. (is a pointer).
@@ -634,7 +634,7 @@ std::vector<std::pair<std::uint64_t, std::uint64_t>> generate_all_encoding_forge
 	return results;
 }
 
-void TREE_DECOMPOSITION::run_operation_forget(std::vector<uint>& bag, int forget_vertex, std::vector<int>& excluded, std::unordered_map<int, int>& newToOldIndex) {
+void TREE_DECOMPOSITION::run_operation_forget(std::vector<uint>& bag, int forget_vertex, std::vector<int>& excluded, const std::vector<int>& newToOldIndex) {
 	timer t_operation_forget;
 	//find index of introduced vertex in the bag.
 	int index_forget_vertex = find_index_in_bag(bag, forget_vertex);
@@ -747,7 +747,7 @@ void generate_encoding_introduce(int n, std::uint64_t coloring, std::uint64_t ch
 	}
 }
 
-void TREE_DECOMPOSITION::run_operation_introduce(std::vector<uint>& bag, int introduced_vertex, std::vector<int>& dominated, std::vector<int>&excluded, std::unordered_map<int,int>& newToOldIndex) {
+void TREE_DECOMPOSITION::run_operation_introduce(std::vector<uint>& bag, int introduced_vertex, std::vector<int>& dominated, std::vector<int>&excluded, const std::vector<int>& newToOldIndex) {
 	timer t_operation_introduce;
 	//find index of introduced vertex in the bag.
 	int index_introduced_vertex = find_index_in_bag_edge(bag, introduced_vertex);
@@ -0,0 +1,152 @@
+#include "worklist.h"
+
+#include <algorithm>
+
+WORKLIST::WORKLIST(MDS_CONTEXT& mds_context, int num_lists, int limit) : mds_context(mds_context), lists(num_lists), limit(limit), epoch(0) {
+    const int n = mds_context.get_total_vertices();
+    const int num_dirty = limit >= 0 ? std::min(n, limit) : n;
+    for (dirty_list& list : lists) {
+        list.in_sweep.assign(n, 0);
+        list.in_pending.assign(n, 0);
+        list.pending.resize(num_dirty);
+        for (int v = 0; v < num_dirty; ++v) {
+            list.pending[v] = v;
+            list.in_pending[v] = 1;
+        }
+    }
+    stamp_changed.assign(n, 0);
+    stamp_frontier.assign(n, 0);
+    stamp_reached.assign(n, 0);
+    mds_context.subscribe_changes(&incoming);
+}
+
+WORKLIST::~WORKLIST() {
+    mds_context.unsubscribe_changes(&incoming);
+}
+
+void WORKLIST::start_sweep(int list_index) {
+    update();
+    dirty_list& list = lists[list_index];
+    //vertices left over from an unfinished sweep stay dirty.
+    std::vector<int> order(list.order.begin() + list.position, list.order.end());
+    for (; !list.late.empty(); list.late.pop()) {
+        order.push_back(list.late.top());
+    }
+    list.sweep_end = limit >= 0 ? limit : mds_context.get_total_vertices();
+    std::vector<int> still_pending;
+    for (int v : list.pending) {
+        if (v >= list.sweep_end) {
+            still_pending.push_back(v);
+            continue;
+        }
+        list.in_pending[v] = 0;
+        if (!list.in_sweep[v]) {
+            list.in_sweep[v] = 1;
+            order.push_back(v);
+        }
+    }
+    std::sort(order.begin(), order.end());
+    list.order = std::move(order);
+    list.position = 0;
+    list.pending = std::move(still_pending);
+    list.cursor = -1;
+    list.active = true;
+}
+
+bool WORKLIST::next(int list_index, int& v) {
+    update();
+    dirty_list& list = lists[list_index];
+    const bool has_order = list.position < list.order.size();
+    if (!has_order && list.late.empty()) {
+        list.active = false;
+        return false;
+    }
+    if (has_order && (list.late.empty() || list.order[list.position] < list.late.top())) {
+        v = list.order[list.position++];
+    } else {
+        v = list.late.top();
+        list.late.pop();
+    }
+    list.in_sweep[v] = 0;
+    list.cursor = v;
+    return true;
+}
+
+bool WORKLIST::empty(int list_index) {
+    update();
+    const dirty_list& list = lists[list_index];
+    return list.pending.empty() && list.position >= list.order.size() && list.late.empty();
+}
+
+void WORKLIST::update() {
+    if (incoming.empty()) {
+        return;
+    }
+    changed.swap(incoming);
+    incoming.clear();
+    const std::size_t n = mds_context.get_total_vertices();
+    if (stamp_changed.size() < n) {
+        stamp_changed.resize(n, 0);
+        stamp_frontier.resize(n, 0);
+        stamp_reached.resize(n, 0);
+        for (dirty_list& list : lists) {
+            list.in_sweep.resize(n, 0);
+            list.in_pending.resize(n, 0);
+        }
+    }
+    if (++epoch == 0) {
+        std::fill(stamp_changed.begin(), stamp_changed.end(), 0);
+        std::fill(stamp_frontier.begin(), stamp_frontier.end(), 0);
+        std::fill(stamp_reached.begin(), stamp_reached.end(), 0);
+        epoch = 1;
+    }
+
+    //the changed vertices and their neighbors.
+    frontier.clear();
+    auto add_frontier = [this](int u) {
+        if (stamp_frontier[u] != epoch) {
+            stamp_frontier[u] = epoch;
+            frontier.push_back(u);
+        }
+    };
+    for (int u : changed) {
+        if (stamp_changed[u] == epoch) {
+            continue;
+        }
+        stamp_changed[u] = epoch;
+        add_frontier(u);
+        for (auto [neigh_itt, neigh_itt_end] = mds_context.get_neighborhood_itt(u); neigh_itt != neigh_itt_end; ++neigh_itt) {
+            add_frontier(*neigh_itt);
+        }
+    }
+    //and one step further, every vertex within distance 2 gets dirty.
+    auto reach = [this](int u) {
+        if (stamp_reached[u] != epoch) {
+            stamp_reached[u] = epoch;
+            mark(u);
+        }
+    };
+    for (int u : frontier) {
+        reach(u);
+        for (auto [neigh_itt, neigh_itt_end] = mds_context.get_neighborhood_itt(u); neigh_itt != neigh_itt_end; ++neigh_itt) {
+            reach(*neigh_itt);
+        }
+    }
+}
+
+void WORKLIST::mark(int v) {
+    if (limit >= 0 && v >= limit) {
+        return;
+    }
+    for (dirty_list& list : lists) {
+        if (list.active && v > list.cursor && v < list.sweep_end) {
+            if (!list.in_sweep[v]) {
+                list.in_sweep[v] = 1;
+                list.late.push(v);
+            }
+        } else if (!list.in_pending[v]) {
+            list.in_pending[v] = 1;
+            list.pending.push_back(v);
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "context.h"
+
+//Dirty vertices of the reduction rules, a rule only looks at a vertex again after something changed near it.
+//the rules read the state, the counters and the edges of the vertices within distance 2, so a change recorded by the
+//context (see MDS_CONTEXT::subscribe_changes) makes every vertex within distance 2 of the changed vertex dirty.
+//a sweep visits the dirty vertices in ascending order, as a sweep over all vertices would: a vertex which gets dirty
+//behind the cursor (or is added during the sweep) waits for the next sweep. the skipped vertices are the ones where
+//no rule can apply, so the rules are applied in the same order as with full sweeps.
+//there is one list per group of rules which is swept on its own, a change makes a vertex dirty in all lists.
+class WORKLIST {
+public:
+    //records the changes of mds_context from now on, all vertices are dirty.
+    //vertices >= limit are never visited, -1 for no limit (then added vertices are visited from the next sweep on).
+    WORKLIST(MDS_CONTEXT& mds_context, int num_lists, int limit);
+
+    ~WORKLIST();
+
+    WORKLIST(const WORKLIST&) = delete;
+    WORKLIST& operator=(const WORKLIST&) = delete;
+
+    //the dirty vertices of list are visited by the next calls of next.
+    void start_sweep(int list);
+
+    //next dirty vertex of the sweep over list, false if the sweep is done.
+    bool next(int list, int& v);
+
+    //true if no vertex of list is dirty.
+    bool empty(int list);
+
+private:
+    struct dirty_list {
+        std::vector<int> order;     // dirty vertices at the start of the sweep, ascending.
+        std::size_t position = 0;
+        std::priority_queue<int, std::vector<int>, std::greater<int>> late; // dirty during the sweep, ahead of the cursor.
+        std::vector<int> pending;   // dirty for the next sweep.
+        std::vector<std::uint8_t> in_sweep;
+        std::vector<std::uint8_t> in_pending;
+        int cursor = -1;
+        int sweep_end = 0;          // vertices >= sweep_end are not visited in this sweep.
+        bool active = false;
+    };
+
+    MDS_CONTEXT& mds_context;
+    std::vector<dirty_list> lists;
+    int limit;
+
+    std::vector<int> incoming;  // change log of mds_context.
+    std::vector<int> changed;
+    std::vector<int> frontier;
+    //epoch stamps to deduplicate the vertices of one update (changed, distance 1, distance 2).
+    std::vector<std::uint32_t> stamp_changed;
+    std::vector<std::uint32_t> stamp_frontier;
+    std::vector<std::uint32_t> stamp_reached;
+    std::uint32_t epoch;
+
+    //makes the vertices near the changes recorded since the last update dirty.
+    void update();
+
+    void mark(int v);
+};
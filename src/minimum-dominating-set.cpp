@@ -13,12 +13,20 @@
 #include <iostream>
 #include "util/logger.h"
 #include <filesystem>
+#include <numeric>
 #include <boost/graph/connected_components.hpp>
 
 #include "sat_solver.h"
 #include "graph/treewidth_solver.h"
 
 #include "util/timer.h"
+#include "util/memory.h"
+#include "util/output_sink.h"
+#include "util/parallel.h"
+#include "graph/kernel_io.h"
+#include "graph/graph_cache.h"
+#include "graph/relabel.h"
+#include "verifier.h"
 #include "graph/generate_tree_decomposition.h"
 #include "ortools/sat/cp_model_solver.h"
 #include <boost/graph/adjacency_list.hpp>
@@ -32,6 +40,9 @@
 
 #include "ortools/graph/graph.h"
 
+//time budget of the reduction rules per component (separate_solver and export_kernel).
+const std::chrono::seconds COMPONENT_REDUCTION_TIMEOUT(1800);
+
 bool stringToBool(const std::string& str) {
 	std::string s = str;
 	std::transform(s.begin(), s.end(), s.begin(), ::tolower); // Convert to lowercase
@@ -81,6 +92,15 @@ strategy_reduction string_to_strategy_reduction(const std::string& str) {
 	throw new std::runtime_error("not a viable strategy");
 }
 
+int string_to_thread_count(const std::string& str) {
+	char* end = nullptr;
+	const long count = std::strtol(str.c_str(), &end, 10);
+	if (str.empty() || *end != '\0' || count < 1 || count > CPU_SETSIZE) {
+		throw std::invalid_argument("not a viable thread count");
+	}
+	return static_cast<int>(count);
+}
+
 void signal_handler(int signum) {
 	std::cout << "Received signal " << signum << ". Stopping the main task...\n";
 	//print temporary results.
@@ -102,6 +122,40 @@ void timer_thread(std::future<void>& main_future){
 
 int main(int argc, char* argv[])
 {
+	//--relabel=<none, rcm, bfs, degree>, --threads=<n>, --cache=<dir> and --cache-checksum can be given anywhere,
+	//the other parameters are positional.
+	int requested_threads = 1;
+	std::string cache_directory;
+	bool cache_checksum = false;
+	std::vector<char*> arguments;
+	for (int i = 0; i < argc; ++i) {
+		std::string argument(argv[i]);
+		if (argument.rfind("--relabel=", 0) == 0) {
+			Logger::relabel_strategy = relabel::string_to_strategy_relabel(argument.substr(10));
+			continue;
+		}
+		if (argument.rfind("--threads=", 0) == 0) {
+			requested_threads = string_to_thread_count(argument.substr(10));
+			continue;
+		}
+		if (argument.rfind("--cache=", 0) == 0) {
+			cache_directory = argument.substr(8);
+			continue;
+		}
+		if (argument == "--cache-checksum") {
+			cache_checksum = true;
+			continue;
+		}
+		arguments.push_back(argv[i]);
+	}
+	//parsed instances are only cached (.grb) in a directory given explicitly.
+	parse::configure_graph_cache(cache_directory, cache_checksum);
+	//output: [options: - (stdout), fd:<n>, directory], the 4th positional parameter (not for verify, there it is the
+	//certificate). configured before anything is printed, so a stdout sink only ever gets the outputs.
+	if (arguments.size() > 4 && std::string(arguments[1]) != "verify") {
+		OUTPUT_SINK::configure(std::string(arguments[4]));
+	}
+
 	 cpu_set_t mask;
 
     // Get the current affinity mask of the process
@@ -110,22 +164,24 @@ int main(int argc, char* argv[])
         return 1;
     }
 
-    // Find the first allowed core and bind to it
-    for (int i = 0; i < CPU_SETSIZE; i++) {
+    // Bind to the first allowed cores, one unless more threads are requested
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    int bound = 0;
+    for (int i = 0; i < CPU_SETSIZE && bound < requested_threads; i++) {
         if (CPU_ISSET(i, &mask)) {
-            cpu_set_t set;
-            CPU_ZERO(&set);
             CPU_SET(i, &set);
-
-            if (sched_setaffinity(0, sizeof(set), &set) == -1) {
-                perror("sched_setaffinity");
-                return 1;
-            }
-
             printf("Bound to CPU %d\n", i);
-            break;
+            bound++;
         }
     }
+    if (sched_setaffinity(0, sizeof(set), &set) == -1) {
+        perror("sched_setaffinity");
+        return 1;
+    }
+    //the parallel loaders and reductions only use the cores bound to.
+    set_available_threads(bound);
+
 	//default values
 	// path : string with path to instance graph.
 	bool dir_mode = false;
@@ -139,13 +195,35 @@ int main(int argc, char* argv[])
 	strategy_solver solver_strategy = SOLVER_NICE_TREE_DECOMPOSITION;
 	strategy_reduction_scheme reduction_scheme_strategy = REDUCTION_ALBER_L_NON;
 
+	argc = arguments.size();
+	argv = arguments.data();
+
+	//verify <instance> <solution> [certificate]: only check an existing solution.
+	if (argc > 3 && std::string(argv[1]) == "verify") {
+		verifier::verification_result result = verifier::verify_solution_file(argv[2], argv[3], argc > 4 ? argv[4] : "");
+		verifier::print_verification(result);
+		return result.valid ? 0 : 1;
+	}
 
 	//be able to take in parameters.
 	if (argc > 1) path = std::string(argv[1]);
 	if (argc > 2) reduction_strategy = string_to_strategy_reduction(std::string(argv[2]));
 	if (argc > 3) solver_strategy = string_to_strategy_solver(std::string(argv[3]));
+	//kernel: reduce the instance once and write the kernel to this path instead of solving.
+	if (argc > 5) {
+		initialize_logger_not_average();
+		export_kernel(path, std::string(argv[5]), reduction_strategy, theory_strategy);
+		return 0;
+	}
+	//a previously exported kernel is solved directly, without running the reductions again.
+	if (path.size() > 7 && path.compare(path.size() - 7, 7, ".kernel") == 0) {
+		initialize_logger_not_average();
+		return solve_kernel(path, solver_strategy) ? 0 : 1;
+	}
 
 	signal(SIGINT, signal_handler);
+	//an invalid solution gives a non-zero exit status.
+	bool valid = true;
 	//Sigint handler.
 	if (dir_mode) {
 		for (const auto& entry : std::filesystem::directory_iterator(dir_path)) {
@@ -155,7 +233,7 @@ int main(int argc, char* argv[])
 				initialize_logger_not_average();
 				//seperate_solver_no_components(entry.path(), reduction_strategy, solver_strategy);
 				//separate_solver_treewidth(entry.path(), reduction_strategy, solver_strategy, reduction_scheme_strategy, theory_strategy);
-				dominating_set_solver(entry.path());
+				valid = dominating_set_solver(entry.path()) && valid;
 				//seperate_solver_no_components(entry.path(), reduction_strategy, solver_strategy);
 				//separate_solver(entry.path(), reduction_strategy, solver_strategy, reduction_scheme_strategy, theory_strategy);
 			}
@@ -168,7 +246,7 @@ int main(int argc, char* argv[])
 			//dominating_set_solver(path);
 
 		}
-		separate_solver(path, reduction_strategy, solver_strategy, reduction_scheme_strategy, theory_strategy);
+		valid = separate_solver(path, reduction_strategy, solver_strategy, reduction_scheme_strategy, theory_strategy);
 		//seperate_solver_no_components(path, reduction_strategy, solver_strategy);
 	}
 
@@ -187,25 +265,25 @@ int main(int argc, char* argv[])
 	//main_thread.join();
 	// Wait for the timer thread to finish (it may finish early if main task completes)
 	//timer.join();
-	return 0;
+	return valid ? 0 : 1;
 }
 
-void dominating_set_solver(std::string path){
+bool dominating_set_solver(std::string path){
 	timer t_complete;
 
-	std::vector<std::unique_ptr<adjacencyListBoost>> sub_components; // subcomponents of the original problem (no reductions).
-	std::vector<std::unordered_map<int, int>> sub_newToOldIndex; // translation function to get back to the original indices.
-	std::vector<std::vector<std::unique_ptr<adjacencyListBoost>>> sub_sub_components; // subcomponents after reduction rules X.1 to X.3 and L.2
-	std::vector<std::vector<std::unordered_map<int, int>>> sub_sub_newToOldIndex; // translation function to get back to the original indices.
-	std::vector<std::vector<MDS_CONTEXT>> reduced_components_context; // AMDS context for each subcomponent.
+	instance_components sub_components; // subcomponents of the original problem (no reductions).
+	std::vector<std::vector<index_map>> sub_sub_newToOldIndex; // translation function to get back to the original indices.
+	std::vector<std::vector<MDS_CONTEXT>> reduced_components_context; // AMDS context for each subcomponent after reduction rules X.1 to X.3 and L.2
+	std::vector<std::vector<CSR_GRAPH>> reduced_components_csr; // graph of each subcomponent.
 	std::vector<std::vector<bool>> is_dominated;
 	std::vector<std::vector<bool>> aggressive_reduction;
 
 	/* Takes the path, loads in the graph, and directly splits it into connected components.
-	sub_components := vector with graphs.
-	sub_newToOldIndex := a vector of maps which given a index of a vertex in a subcomponent translates the index
+	sub_components.newToOldIndex := a vector of maps which given a index of a vertex in a subcomponent translates the index
 	to the original index of the vertex. */
-	create_component_subgraphs(path, sub_components, sub_newToOldIndex);
+	std::unique_ptr<CSR_GRAPH> instance = std::make_unique<CSR_GRAPH>(parse::load_pace_2024_csr(path));
+	create_component_subgraphs(path, instance, sub_components);
+	Logger::peak_rss_load = peak_rss_kb();
 
 	std::vector<int>solution; // vector which will hold all vertices in the optimal dominating set.
 
@@ -214,7 +292,12 @@ void dominating_set_solver(std::string path){
 		/*Try to solve the subcomponent which a minute with the SAT_solver.
 		 this either provides a solution (OPTIMAL), or provides an upperbound (FEASIBlE).
 		 */
-		MDS_CONTEXT mds_context = MDS_CONTEXT(*sub_components[i]);
+		MDS_CONTEXT mds_context = create_component_context(sub_components, i);
+		//every component has its own context, the instance is not needed anymore.
+		if (i + 1 == sub_components.size()) {
+			release_components(path, instance, sub_components);
+		}
+		Logger::max_context_bytes = std::max(Logger::max_context_bytes, static_cast<long long>(mds_context.memory_bytes()));
 
 		// start reduction rule X.1 to X.3 without actual removing any vertices
 		strategy_reduction reduction_strategy_combination = REDUCTION_COMBINATION;
@@ -223,67 +306,66 @@ void dominating_set_solver(std::string path){
 		mds_context.fill_removed_vertex();
 
 		// Fill the solution with vertices which must be in the dominating set.
-		for (int v = 0; v < mds_context.selected.size(); ++v) {
+		TRANSLATION_CHAIN component_chain;
+		component_chain.push_layer(sub_components.newToOldIndex[i]);
+		for (int v = 0; v < mds_context.state.size(); ++v) {
 			if (mds_context.is_selected(v)) {
-				// Adjust by +1 to convert from 0-indexed to 1-indexed vertices.
-				solution.push_back(sub_newToOldIndex[i][v] + 1);
+				// 1-indexed vertex of the instance.
+				solution.push_back(component_chain.solution_vertex(v));
 			}
 		}
 
-		//The previous reductions could split up problems into smaller sub-problems.
-		sub_sub_components.emplace_back();
+		//The previous reductions could split up problems into smaller sub-problems (views of the graph of mds_context).
 		sub_sub_newToOldIndex.emplace_back();
 		is_dominated.emplace_back();
 		aggressive_reduction.emplace_back();
-
-		std::unordered_map<int, int> newToOldIndex;
-		adjacencyListBoost reduced_graph = create_reduced_graph(mds_context, newToOldIndex);
-		create_reduced_component_subgraphs(reduced_graph, sub_sub_components[i], sub_sub_newToOldIndex[i], newToOldIndex);
-
 		reduced_components_context.emplace_back();
-
-		for (int j = 0; j < sub_sub_components[i].size(); ++j) {
-			reduced_components_context[i].emplace_back(*sub_sub_components[i][j]);
-			reduced_components_context[i][j].fill_mds_context(mds_context, sub_sub_newToOldIndex[i][j]);
+		reduced_components_csr.emplace_back();
+
+		std::vector<SUBGRAPH_VIEW> component_views = create_reduced_component_views(mds_context);
+		for (int j = 0; j < component_views.size(); ++j) {
+			reduced_components_context[i].emplace_back(component_views[j]);
+			reduced_components_context[i][j].fill_mds_context(mds_context, component_views[j].local_to_global());
+			//the solvers and htd read the component as CSR graph.
+			reduced_components_csr[i].push_back(component_views[j].to_csr());
+			sub_sub_newToOldIndex[i].push_back(component_views[j].local_to_global());
 			is_dominated[i].emplace_back(false);
 			aggressive_reduction[i].emplace_back(false);
 		}
+		//every view has been copied into its own context, the graph they point into is not needed anymore.
+		component_views.clear();
+		mds_context.release_graph();
 	}
 	std::cout << "start treewidth" << std::endl;
 	//For each component if it small enough approximate the treewidth.
 	for (int i = 0; i < sub_components.size(); ++i) {
 
-		for (int j = 0; j < sub_sub_components[i].size(); ++j)
+		for (int j = 0; j < reduced_components_context[i].size(); ++j)
 		{
 			//Fill identify function
-			std::unordered_map<int, int> identity_map;
-			for (int q = 0; q < boost::num_vertices(*sub_sub_components[i][j]); ++q) {
-				identity_map[q] = q;
-			}
+			index_map identity_map(reduced_components_csr[i][j].num_vertices);
+			std::iota(identity_map.begin(), identity_map.end(), 0);
+			TRANSLATION_CHAIN chain;
+			chain.push_layer(sub_components.newToOldIndex[i]);
+			chain.push_layer(sub_sub_newToOldIndex[i][j]);
 
-			if (boost::num_vertices(*sub_sub_components[i][j]) < 20000){
+			if (reduced_components_csr[i][j].num_vertices < 20000){
 				//Approximate treewidth.
-				std::unique_ptr<NICE_TREE_DECOMPOSITION> nice_tree_decomposition = generate_td_approx(*sub_sub_components[i][j]);
+				std::unique_ptr<NICE_TREE_DECOMPOSITION> nice_tree_decomposition = generate_td_approx(reduced_components_csr[i][j]);
 				if (nice_tree_decomposition == nullptr) {
 					if (Logger::is_medium) {
 						aggressive_reduction[i][j] = Logger::is_medium;
 					} else {
-						std::vector<int> partial_solution = sat_solver_dominating_set(reduced_components_context[i][j], *sub_sub_components[i][j], identity_map);
-						for (int newIndex : partial_solution) {
-							auto sub_index = sub_sub_newToOldIndex[i][j][newIndex];
-							solution.push_back((sub_newToOldIndex[i][sub_index]) + 1);
-						}
+						std::vector<int> partial_solution = sat_solver_dominating_set(reduced_components_context[i][j], reduced_components_csr[i][j], identity_map);
+						chain.lift(partial_solution, solution);
 						is_dominated[i][j] = true;
 					}
 					Logger::is_medium = false;
 				} else {
-						std::unique_ptr<TREEWIDTH_SOLVER> td_comp = std::make_unique<TREEWIDTH_SOLVER>(std::move(nice_tree_decomposition), reduced_components_context[i][j].dominated, reduced_components_context[i][j].excluded, identity_map);
+						std::unique_ptr<TREEWIDTH_SOLVER> td_comp = std::make_unique<TREEWIDTH_SOLVER>(std::move(nice_tree_decomposition), reduced_components_context[i][j].get_state_vector(STATE_DOMINATED), reduced_components_context[i][j].get_state_vector(STATE_EXCLUDED), identity_map);
 
 						//generate final solution.
-						for (int newIndex : td_comp->global_solution) {
-							auto sub_index = sub_sub_newToOldIndex[i][j][newIndex];
-							solution.push_back((sub_newToOldIndex[i][sub_index]) + 1);
-						}
+						chain.lift(td_comp->global_solution, solution);
 						is_dominated[i][j] = true;
 				}
 			}
@@ -299,7 +381,7 @@ void dominating_set_solver(std::string path){
 
 	for (int i = 0; i < sub_components.size(); ++i) {
 		int rule_id = 3;
-		for (int j = 0; j < sub_sub_components[i].size(); ++j) {
+		for (int j = 0; j < reduced_components_context[i].size(); ++j) {
 			//no further reductions possible.
 			if (reduced_components_context[i][j].num_undetermined_vertices() == 0 || is_dominated[i][j] || !aggressive_reduction[i][j]){
 				continue;
@@ -310,7 +392,7 @@ void dominating_set_solver(std::string path){
 
 	for (int i = 0; i < sub_components.size(); ++i) {
 		int rule_id = 4;
-		for (int j = 0; j < sub_sub_components[i].size(); ++j) {
+		for (int j = 0; j < reduced_components_context[i].size(); ++j) {
 			//no further reductions possible.
 			if (reduced_components_context[i][j].num_undetermined_vertices() == 0 || is_dominated[i][j] || !aggressive_reduction[i][j]){
 				continue;
@@ -319,104 +401,119 @@ void dominating_set_solver(std::string path){
 		}
 	}
 
+	Logger::peak_rss_reduction = peak_rss_kb();
+
 	// Fill the solution with vertices which must be in the dominating set because of the reduction rules.
 
 	for (int i = 0; i < sub_components.size(); ++i){
-		for (int j = 0; j < sub_sub_components[i].size(); ++j)
+		for (int j = 0; j < reduced_components_context[i].size(); ++j)
 		{
 			if (is_dominated[i][j]){
 				continue;
 			}
 			reduced_components_context[i][j].fill_removed_vertex();
-			for (int v = 0; v < reduced_components_context[i][j].selected.size(); ++v){
-				//we need a +1 te correct the previous -1.
+			TRANSLATION_CHAIN chain;
+			chain.push_layer(sub_components.newToOldIndex[i]);
+			chain.push_layer(sub_sub_newToOldIndex[i][j]);
+			for (int v = 0; v < reduced_components_context[i][j].state.size(); ++v){
 				if (reduced_components_context[i][j].is_selected(v)){
-					solution.push_back(((sub_newToOldIndex[i][sub_sub_newToOldIndex[i][j][v]]) + 1));
+					solution.push_back(chain.solution_vertex(v));
 				}
 			}
 			//These reduction rules can cause components to subdivide into subcomponents so split them.
-			std::vector<std::unique_ptr<adjacencyListBoost>> sub_sub_sub_components;
-			std::vector<std::unordered_map<int, int>> sub_sub_sub_newToOldIndex;
-
-			std::unordered_map<int, int> newToOld;
-			adjacencyListBoost reduced_graph = create_reduced_graph(reduced_components_context[i][j], newToOld);
-			create_reduced_component_subgraphs(reduced_graph, sub_sub_sub_components, sub_sub_sub_newToOldIndex, newToOld);
-
-			for (int q = 0; q < sub_sub_sub_components.size(); ++q) {
-				std::vector<int> partial_solution = sat_solver_dominating_set(reduced_components_context[i][j], *sub_sub_sub_components[q], sub_sub_sub_newToOldIndex[q]);
-				for (int newIndex : partial_solution) {
-					auto sub_index = sub_sub_newToOldIndex[i][j][sub_sub_sub_newToOldIndex[q][newIndex]];
-					solution.push_back((sub_newToOldIndex[i][sub_index]) + 1);
-				}
+			std::vector<SUBGRAPH_VIEW> sub_component_views = create_reduced_component_views(reduced_components_context[i][j]);
+
+			for (int q = 0; q < sub_component_views.size(); ++q) {
+				std::vector<int> partial_solution = sat_solver_dominating_set(reduced_components_context[i][j], sub_component_views[q]);
+				chain.push_layer(sub_component_views[q].local_to_global());
+				chain.lift(partial_solution, solution);
+				chain.pop_layer();
 			}
 		}
 	}
+	Logger::peak_rss_solver = peak_rss_kb();
 	std::cout << solution.size() << std::endl;
+	const bool valid = verify_solution(path, instance, solution);
 	parse::output_solution(solution, path);
 	std::ofstream outfile("/home/floris/github/minimum-dominating-set/score.txt", std::ios::app);
 	if (!outfile) {
 		std::cerr << "Error: Could not open file for writing.\n";
-		return;
+		return valid;
 	}
 	outfile << "instance:" + path + "\n";
 	outfile << "domination number: " << solution.size() << "\n";
 	outfile << "execution time: " << t_complete.count() << "\n";
+	outfile << "peak rss (KB): load " << Logger::peak_rss_load << ", reduction " << Logger::peak_rss_reduction << ", solver " << Logger::peak_rss_solver << (Logger::instance_kept ? " (instance kept)" : "") << "\n";
 	outfile << "\n";
 	outfile.close();
+	return valid;
 }
 
 
-void separate_solver(std::string path, strategy_reduction red_strategy, strategy_solver sol_strategy, strategy_reduction_scheme red_scheme_strategy, bool theory_strategy){
+bool separate_solver(std::string path, strategy_reduction red_strategy, strategy_solver sol_strategy, strategy_reduction_scheme red_scheme_strategy, bool theory_strategy){
 	timer t_complete;
 	Logger::solver_strategy = sol_strategy;
 	Logger::reduction_strategy = red_strategy;
 	Logger::reduction_scheme_strategy = red_scheme_strategy;
 	//create empty sub-graphs + translation function.
-	std::vector<std::unique_ptr<adjacencyListBoost>> sub_components;
-	std::vector<std::unordered_map<int, int>> sub_newToOldIndex;
+	instance_components sub_components;
 
 	//Fill sub-graphs + translation function (no reduction).
-	create_component_subgraphs(path, sub_components, sub_newToOldIndex);
+	std::unique_ptr<CSR_GRAPH> instance = std::make_unique<CSR_GRAPH>(parse::load_pace_2024_csr(path));
+	create_component_subgraphs(path, instance, sub_components);
+	Logger::peak_rss_load = peak_rss_kb();
 	std::vector<int>solution;
 
+	//a precomputed decomposition (instance.td next to the instance) is used instead of htd where it fits.
+	std::unique_ptr<parse::td_file> precomputed_td;
+	if (std::filesystem::exists(parse::get_td_path(path))) {
+		precomputed_td = std::make_unique<parse::td_file>(parse::load_pace_td(parse::get_td_path(path)));
+	}
+
 	for (int i = 0; i < sub_components.size(); ++i){
 		//Create a mds_context & reduce. for each subgraph.
 		std::atomic<bool> stop_flag(false);
-		MDS_CONTEXT mds_context = MDS_CONTEXT(*sub_components[i]);
+		MDS_CONTEXT mds_context = create_component_context(sub_components, i);
+		//every component has its own context, the instance is not needed anymore.
+		if (i + 1 == sub_components.size()) {
+			release_components(path, instance, sub_components);
+		}
+		Logger::max_context_bytes = std::max(Logger::max_context_bytes, static_cast<long long>(mds_context.memory_bytes()));
 		timer t_reduction;
 		auto start = std::chrono::steady_clock::now();
-		auto timeout_duration = std::chrono::seconds(1800);
+		auto timeout_duration = COMPONENT_REDUCTION_TIMEOUT;
 		reduce::reduction_rule_manager(mds_context, red_strategy, 0, theory_strategy, start, timeout_duration);
 
 		Logger::execution_time_reduction += t_reduction.count();
 		mds_context.fill_removed_vertex();
+		Logger::peak_rss_reduction = peak_rss_kb();
 
 		Logger::cnt_selected_vertices += mds_context.cnt_sel;
 		//Logger::cnt_excluded_vertices += mds_context.cnt_excl;
 		//Logger::cnt_ignored_vertices += mds_context.cnt_ign;
 		Logger::cnt_removed_vertices += mds_context.cnt_rem;
 
-		for (int v = 0; v < mds_context.selected.size(); ++v) {
+		TRANSLATION_CHAIN component_chain;
+		component_chain.push_layer(sub_components.newToOldIndex[i]);
+		for (int v = 0; v < mds_context.state.size(); ++v) {
 			if (mds_context.is_selected(v)) {
-				//we need a +1 te correct the previous -1.
-				solution.push_back(sub_newToOldIndex[i][v] + 1);
+				solution.push_back(component_chain.solution_vertex(v));
 			}
 		}
 
-		//Has reduction broke up a subgraph, into multiple sub-graphs.
-		std::vector<std::unique_ptr<adjacencyListBoost>> sub_sub_components;
-		std::vector<std::unordered_map<int, int>> sub_sub_newToOldIndex;
-
-		std::unordered_map<int, int> newToOldIndex;
-		adjacencyListBoost reduced_graph = create_reduced_graph(mds_context, newToOldIndex);
-		create_reduced_component_subgraphs(reduced_graph, sub_sub_components, sub_sub_newToOldIndex, newToOldIndex);
+		//Has reduction broke up a subgraph, into multiple sub-graphs (views of the graph of mds_context).
+		std::vector<SUBGRAPH_VIEW> component_views = create_reduced_component_views(mds_context);
 		//Solve each subgraph with a solver.
-		for (int j = 0; j < sub_sub_components.size(); ++j)
+		for (int j = 0; j < component_views.size(); ++j)
 		{
 
 			//get new MDS_CONTEXT.
-			MDS_CONTEXT mds_context_reduced = MDS_CONTEXT(*sub_sub_components[j]);
-			mds_context_reduced.fill_mds_context(mds_context, sub_sub_newToOldIndex[j]);
+			MDS_CONTEXT mds_context_reduced = MDS_CONTEXT(component_views[j]);
+			mds_context_reduced.fill_mds_context(mds_context, component_views[j].local_to_global());
+			//every view has been copied into its own context, the graph they point into is not needed anymore.
+			if (j + 1 == static_cast<int>(component_views.size())) {
+				mds_context.release_graph();
+			}
 
 			strategy_reduction strategy = REDUCTION_L_ALBER;
 			// std::future<void> l_reduction = std::async(std::launch::async, reduce::reduction_rule_manager, std::ref(mds_context_reduced), std::ref(strategy), 4, std::ref(stop_flag));
@@ -454,11 +551,12 @@ void separate_solver(std::string path, strategy_reduction red_strategy, strategy
 			//Logger::cnt_ignored_vertices += mds_context_reduced.cnt_ign;
 			Logger::cnt_removed_vertices += mds_context_reduced.cnt_rem;
 
-			std::unordered_map<int, int> newToOld;
-			for (int v = 0; v < mds_context_reduced.selected.size(); ++v) {
+			TRANSLATION_CHAIN chain;
+			chain.push_layer(sub_components.newToOldIndex[i]);
+			chain.push_layer(component_views[j].local_to_global());
+			for (int v = 0; v < mds_context_reduced.state.size(); ++v) {
 				if (mds_context_reduced.is_selected(v)) {
-					//we need a +1 te correct the previous -1.
-					solution.push_back(((sub_newToOldIndex[i][sub_sub_newToOldIndex[j][v]]) + 1));
+					solution.push_back(chain.solution_vertex(v));
 					Logger::cnt_selected_vertices++;
 					continue;
 				}
@@ -481,14 +579,23 @@ void separate_solver(std::string path, strategy_reduction red_strategy, strategy
 					Logger::cnt_ignored_vertices++;
 				}
 			}
-			adjacencyListBoost more_reduced = create_reduced_graph(mds_context_reduced, newToOld);
+			SUBGRAPH_VIEW more_reduced = create_reduced_view(mds_context_reduced);
+			chain.push_layer(more_reduced.local_to_global());
 			//bool is_planar = boost::boyer_myrvold_planarity_test(more_reduced);
 			//std::cout << is_planar << std::endl;
 
 
 			if (sol_strategy == SOLVER_NICE_TREE_DECOMPOSITION){
 				timer t_nice_tree_decomposition;
-				std::unique_ptr<NICE_TREE_DECOMPOSITION> nice_tree_decomposition = generate_td(more_reduced);
+				std::unique_ptr<NICE_TREE_DECOMPOSITION> nice_tree_decomposition;
+				const CSR_GRAPH more_reduced_csr = more_reduced.to_csr();
+				if (precomputed_td) {
+					index_map newToOriginal = chain.compose();
+					nice_tree_decomposition = generate_td_precomputed(more_reduced_csr, *precomputed_td, newToOriginal);
+				}
+				if (nice_tree_decomposition == nullptr) {
+					nice_tree_decomposition = generate_td(more_reduced_csr);
+				}
 				if (nice_tree_decomposition)
 				{
 					Logger::treewidth.push_back(nice_tree_decomposition->treewidth);
@@ -501,60 +608,89 @@ void separate_solver(std::string path, strategy_reduction red_strategy, strategy
 			if (sol_strategy == SOLVER_TREEWIDTH)
 			{
 				timer t_treewidth;
-				std::unique_ptr<NICE_TREE_DECOMPOSITION> nice_tree_decomposition = generate_td(more_reduced);
+				std::unique_ptr<NICE_TREE_DECOMPOSITION> nice_tree_decomposition;
+				const CSR_GRAPH more_reduced_csr = more_reduced.to_csr();
+				if (precomputed_td) {
+					index_map newToOriginal = chain.compose();
+					nice_tree_decomposition = generate_td_precomputed(more_reduced_csr, *precomputed_td, newToOriginal);
+				}
+				if (nice_tree_decomposition == nullptr) {
+					nice_tree_decomposition = generate_td(more_reduced_csr);
+				}
 				if (nice_tree_decomposition == nullptr)
 				{
 					throw std::runtime_error("tree decomposition is to big");
 				}
-				std::unique_ptr<TREEWIDTH_SOLVER> td_comp = std::make_unique<TREEWIDTH_SOLVER>(std::move(nice_tree_decomposition), mds_context_reduced.dominated, mds_context_reduced.excluded, newToOld);
+				std::unique_ptr<TREEWIDTH_SOLVER> td_comp = std::make_unique<TREEWIDTH_SOLVER>(std::move(nice_tree_decomposition), mds_context_reduced.get_state_vector(STATE_DOMINATED), mds_context_reduced.get_state_vector(STATE_EXCLUDED), more_reduced.local_to_global());
 
 				//generate final solution.
-				for (int newIndex : td_comp->global_solution) {
-					auto sub_index = sub_sub_newToOldIndex[j][newToOld[newIndex]];
-					solution.push_back((sub_newToOldIndex[i][sub_index]) + 1);
-				}
+				chain.lift(td_comp->global_solution, solution);
 				Logger::execution_time_treewidth += t_treewidth.count();
 			}
 			else if (sol_strategy == SOLVER_ILP) {
 				timer t_ilp;
-				std::vector<int> partial_solution = operations_research::ilp_solver(mds_context_reduced, more_reduced, newToOld);
+				std::vector<int> partial_solution = operations_research::ilp_solver(mds_context_reduced, more_reduced);
 
-				for (int newIndex : partial_solution) {
-					auto sub_index = sub_sub_newToOldIndex[j][newToOld[newIndex]];
-					solution.push_back((sub_newToOldIndex[i][sub_index]) + 1);
-				}
+				chain.lift(partial_solution, solution);
 				Logger::execution_time_ilp += t_ilp.count();
 			}
 			else if (sol_strategy == SOLVER_SAT) {
 				timer t_sat;
-				std::vector<int> partial_solution = sat_solver_dominating_set(mds_context_reduced, more_reduced, newToOld);
+				std::vector<int> partial_solution = sat_solver_dominating_set(mds_context_reduced, more_reduced);
 
-				for (int newIndex : partial_solution) {
-					auto sub_index = sub_sub_newToOldIndex[j][newToOld[newIndex]];
-					solution.push_back((sub_newToOldIndex[i][sub_index]) + 1);
-				}
+				chain.lift(partial_solution, solution);
 				Logger::execution_time_sat += t_sat.count();
 				//Logger::average_SAT_execution_time.push_back(t_sat.count());
 			}
 		}
 	}
+	Logger::peak_rss_solver = peak_rss_kb();
 	Logger::domination_number = solution.size();
 	std::cout << solution.size() << std::endl;
 	Logger::execution_time_complete = t_complete.count();
 	std::cout << Logger::execution_time_complete << std::endl;
 	Logger::average_SAT_execution_time.push_back(Logger::execution_time_sat);
+	const bool valid = verify_solution(path, instance, solution);
 	parse::output_solution(solution, path);
 	std::string name = parse::getNameFile(path);
 	output_loginfo(name);
+	return valid;
+}
+
+bool verify_solution(const CSR_GRAPH& instance, std::vector<int>& solution) {
+	verifier::verification_result result = verifier::verify_dominating_set(instance, solution);
+	verifier::print_verification(result);
+	return result.valid;
 }
 
-void seperate_solver_no_components(std::string path, strategy_reduction red_strategy, strategy_solver sol_strategy){
+void release_instance(const std::string& path, std::unique_ptr<CSR_GRAPH>& instance) {
+	if (path != "-" && std::filesystem::is_regular_file(path)) {
+		instance.reset();
+	}
+	Logger::instance_kept = instance != nullptr;
+}
+
+bool verify_solution(const std::string& path, std::unique_ptr<CSR_GRAPH>& instance, std::vector<int>& solution) {
+	if (!instance) {
+		//the edges dropped while loading were counted the first time.
+		const long long duplicates = Logger::cnt_duplicate_edges;
+		const long long self_loops = Logger::cnt_self_loops;
+		instance = std::make_unique<CSR_GRAPH>(parse::load_pace_2024_csr(path));
+		Logger::cnt_duplicate_edges = duplicates;
+		Logger::cnt_self_loops = self_loops;
+	}
+	return verify_solution(*instance, solution);
+}
+
+bool seperate_solver_no_components(std::string path, strategy_reduction red_strategy, strategy_solver sol_strategy){
 	timer t_complete;
 	Logger::solver_strategy = sol_strategy;
 	Logger::reduction_strategy = red_strategy;
 	std::atomic<bool> stop_flag(false);
 
-	std::unique_ptr<adjacencyListBoost> graph = std::make_unique<adjacencyListBoost>(parse::load_pace_2024(path));
+	//kept to verify the solution, the instance is read only once.
+	const CSR_GRAPH instance = parse::load_pace_2024_csr(path);
+	std::unique_ptr<adjacencyListBoost> graph = std::make_unique<adjacencyListBoost>(parse::construct_AdjacencyList_Boost(instance));
 	MDS_CONTEXT mds_context = MDS_CONTEXT(*graph);
 	timer t_reduction;
 	//reduce::reduction_rule_manager(mds_context, red_strategy, 0, stop_flag, false);
@@ -568,11 +704,11 @@ void seperate_solver_no_components(std::string path, strategy_reduction red_stra
 	Logger::cnt_removed_vertices += mds_context.cnt_rem;
 	Logger::cnt_dominated_vertices += mds_context.cnt_dom;
 
-	std::unordered_map<int, int> newToOldIndex;
+	index_map newToOldIndex;
 	auto reduced_graph = create_reduced_graph(mds_context,newToOldIndex);
 
 	std::vector<int> solution;
-	for (int v = 0; v < mds_context.selected.size(); ++v) {
+	for (int v = 0; v < mds_context.state.size(); ++v) {
 		if (mds_context.is_selected(v)) {
 			//we need a +1 te correct the previous -1.
 			solution.push_back(v + 1);
@@ -597,171 +733,179 @@ void seperate_solver_no_components(std::string path, strategy_reduction red_stra
 	Logger::execution_time_complete = t_complete.count();
 	std::cout << Logger::execution_time_complete << std::endl;
 	Logger::average_SAT_execution_time.push_back(Logger::execution_time_sat);
+	const bool valid = verify_solution(instance, solution);
 	parse::output_solution(solution, path);
 	std::string name = parse::getNameFile(path);
 	output_loginfo(name);
+	return valid;
 }
 
-void create_reduced_component_subgraphs(adjacencyListBoost& reduced_graph,
-										std::vector<std::unique_ptr<adjacencyListBoost>>& sub_sub_components,
-										std::vector<std::unordered_map<int, int>>& sub_sub_newToOldIndex,
-										std::unordered_map<int, int>& newToOldIndex){
-
-	std::vector<int> component_map(boost::num_vertices(reduced_graph));
-	int num_components = boost::connected_components(reduced_graph, &component_map[0]);
-	sub_sub_components.resize(num_components);
-	sub_sub_newToOldIndex.resize(num_components);
-	//Logger::num_reduced_components += num_components;
-
-	if (num_components == 1){
-		sub_sub_components[0] = std::make_unique<adjacencyListBoost>(reduced_graph);
-		sub_sub_newToOldIndex[0] = newToOldIndex;
-		return;
-	}
+void export_kernel(std::string path, std::string kernel_path, strategy_reduction red_strategy, bool theory_strategy) {
+	Logger::reduction_strategy = red_strategy;
+	instance_components sub_components;
+	std::unique_ptr<CSR_GRAPH> instance = std::make_unique<CSR_GRAPH>(parse::load_pace_2024_csr(path));
+	const int num_original_vertices = instance->num_vertices;
+	create_component_subgraphs(path, instance, sub_components);
 
-	std::vector<std::vector<int>> components(num_components);
+	//the components are reduced like separate_solver does, so the kernel is the one the solvers would get.
+	parse::KERNEL_WRITER kernel;
+	for (int i = 0; i < sub_components.size(); ++i) {
+		MDS_CONTEXT mds_context = create_component_context(sub_components, i);
+		if (i + 1 == sub_components.size()) {
+			release_components(path, instance, sub_components);
+		}
+		timer t_reduction;
+		int rule_id = (red_strategy == REDUCTION_L_ALBER) ? 3 : 0;
+		reduce::reduction_rule_manager(mds_context, red_strategy, rule_id, theory_strategy, std::chrono::steady_clock::now(), COMPONENT_REDUCTION_TIMEOUT);
+		Logger::execution_time_reduction += t_reduction.count();
+		mds_context.fill_removed_vertex();
 
-	//distribute components.
-	for (size_t i = 0; i < component_map.size(); ++i) {
-		components[component_map[i]].push_back(i);
+		//vertices added by the reduction rules (gadgets) have no original vertex.
+		std::vector<int> kernelToOriginal(mds_context.get_total_vertices(), -1);
+		std::copy(sub_components.newToOldIndex[i].begin(), sub_components.newToOldIndex[i].end(), kernelToOriginal.begin());
+		kernel.add(mds_context, kernelToOriginal);
 	}
+	kernel.write(num_original_vertices, path, kernel_path);
+}
 
-	//Create empty sub graphs.
-	for (size_t i = 0; i < components.size(); ++i) {
-		std::unique_ptr<adjacencyListBoost> sub_sub_component = std::make_unique<adjacencyListBoost>(components[i].size());
-		sub_sub_components[i] = std::move(sub_sub_component);
+bool solve_kernel(std::string kernel_path, strategy_solver sol_strategy) {
+	//the other strategies do not produce a dominating set.
+	if (sol_strategy != SOLVER_SAT && sol_strategy != SOLVER_ILP && sol_strategy != SOLVER_TREEWIDTH) {
+		throw std::invalid_argument("a kernel can only be solved with the sat, ilp or treewidth solver");
 	}
+	timer t_complete;
+	Logger::solver_strategy = sol_strategy;
+	parse::kernel_instance kernel = parse::load_kernel(kernel_path);
+	MDS_CONTEXT& mds_context = *kernel.mds_context;
 
-	//translate function.
-	for (size_t i = 0; i < boost::num_vertices(reduced_graph); ++i) {
-		int component_i = component_map[i];
-		auto it_i = std::find(components[component_i].begin(), components[component_i].end(), i);
-		auto index_i = std::distance(components[component_i].begin(), it_i);
-		sub_sub_newToOldIndex[component_i].insert({index_i,newToOldIndex[i]});
+	//vertices the reduction rules already selected.
+	std::vector<int> kernel_solution;
+	for (int v = 0; v < mds_context.get_total_vertices(); ++v) {
+		if (mds_context.is_selected(v)) {
+			kernel_solution.push_back(v);
+		}
 	}
 
-	//add all edges.
-	for (auto edge_iter = edges(reduced_graph); edge_iter.first != edge_iter.second; ++edge_iter.first) {
-		auto u = source(*edge_iter.first, reduced_graph);
-		auto v = target(*edge_iter.first, reduced_graph);
-		int component_u = component_map[u];
-		int component_v = component_map[v];
-
-		if (component_u == component_v) {
-			auto it_u = std::find(components[component_u].begin(), components[component_u].end(), u);
-			auto it_v = std::find(components[component_v].begin(), components[component_v].end(), v);
-			auto index_u = std::distance(components[component_u].begin(), it_u);
-			auto index_v = std::distance(components[component_v].begin(), it_v);
-			boost::add_edge(index_u, index_v, *sub_sub_components[component_u]);
-			//sub_sub_newToOldIndex[component_u].insert({index_u,newToOldIndex[u]});
-			//sub_sub_newToOldIndex[component_v].insert({index_v,newToOldIndex[v]});
+	std::vector<SUBGRAPH_VIEW> component_views = create_reduced_component_views(mds_context);
+
+	for (int q = 0; q < component_views.size(); ++q) {
+		std::vector<int> partial_solution;
+		if (sol_strategy == SOLVER_ILP) {
+			timer t_ilp;
+			partial_solution = operations_research::ilp_solver(mds_context, component_views[q]);
+			Logger::execution_time_ilp += t_ilp.count();
+		} else if (sol_strategy == SOLVER_TREEWIDTH) {
+			timer t_treewidth;
+			std::unique_ptr<NICE_TREE_DECOMPOSITION> nice_tree_decomposition = generate_td(component_views[q].to_csr());
+			if (nice_tree_decomposition == nullptr) {
+				throw std::runtime_error("tree decomposition is to big");
+			}
+			TREEWIDTH_SOLVER td_comp(std::move(nice_tree_decomposition), mds_context.get_state_vector(STATE_DOMINATED), mds_context.get_state_vector(STATE_EXCLUDED), component_views[q].local_to_global());
+			partial_solution = td_comp.global_solution;
+			Logger::execution_time_treewidth += t_treewidth.count();
 		} else {
-			throw std::runtime_error("Edge endpoints must always be in the same component.");
+			timer t_sat;
+			partial_solution = sat_solver_dominating_set(mds_context, component_views[q]);
+			Logger::execution_time_sat += t_sat.count();
+		}
+		for (int newIndex : partial_solution) {
+			kernel_solution.push_back(component_views[q].global(newIndex));
 		}
 	}
 
-
+	std::vector<int> solution = parse::lift_solution(kernel, kernel_solution);
+	Logger::execution_time_complete = t_complete.count();
+	std::cout << solution.size() << std::endl;
+	//the kernel only holds the reduced graph, the solution is checked against the instance it was exported from.
+	bool valid = true;
+	if (kernel.instance_path != "-" && std::filesystem::is_regular_file(kernel.instance_path)) {
+		valid = verify_solution(parse::load_pace_2024_csr(kernel.instance_path), solution);
+	} else {
+		std::cerr << "instance " << kernel.instance_path << " can not be read again, the solution is not verified" << std::endl;
+	}
+	parse::output_solution(solution, kernel_path);
+	return valid;
 }
 
-void split_graph_component(adjacencyListBoost& graph ,std::vector<std::unique_ptr<adjacencyListBoost>>& sub_components,
-								std::vector<std::unordered_map<int, int>>& sub_newToOldIndex) {
+void create_component_subgraphs(const std::string& path, std::unique_ptr<CSR_GRAPH>& instance, instance_components& components){
 
-}
-
-void create_component_subgraphs(const std::string& path,
-								std::vector<std::unique_ptr<adjacencyListBoost>>& sub_components,
-								std::vector<std::unordered_map<int, int>>& sub_newToOldIndex){
+	Logger::num_vertices = instance->num_vertices;
+	Logger::num_edges = instance->num_edges;
 
-	std::unique_ptr<adjacencyListBoost> graph = std::make_unique<adjacencyListBoost>(parse::load_pace_2024(path));
-	Logger::num_vertices = num_vertices(*graph);
-	Logger::num_edges = num_edges(*graph);
+	//neighbors get nearby ids (cache locality in the reductions), newToOldIndex still translates to the ids of the instance.
+	std::vector<int> relabelToOriginal;
+	components.graph = instance.get();
+	if (Logger::relabel_strategy != RELABEL_NON) {
+		relabelToOriginal = relabel::compute_order(*instance, Logger::relabel_strategy);
+		components.relabeled = relabel::apply_order(*instance, relabelToOriginal);
+		components.graph = &components.relabeled;
+		release_instance(path, instance);
+	}
+	const CSR_GRAPH& graph = *components.graph;
 
 	//Find components (which can be solved separately).
-	std::vector<int> component_map(boost::num_vertices(*graph));
-	int num_components = boost::connected_components(*graph, &component_map[0]);
+	std::vector<int> component_map;
+	int num_components = graph.connected_components(component_map);
 	Logger::num_components = num_components;
 
-	sub_components.resize(num_components);
-	sub_newToOldIndex.resize(num_components);
-
-	//no different components.
-	if (num_components == 1){
-
-		for (int q = 0; q < boost::num_vertices(*graph); q++) {
-			sub_newToOldIndex[0].insert({q, q});
-		}
-		sub_components[0] = std::move(graph);
-		return;
-	}
-
-	std::vector<std::vector<int>> components(num_components);
-
-	//distribute components.
-	for (size_t i = 0; i < component_map.size(); ++i) {
-		components[component_map[i]].push_back(i);
-	}
-
-	//Create empty sub graphs.
-	for (size_t i = 0; i < components.size(); ++i) {
-		Logger::num_vertices_components.push_back(components[i].size());
-		std::unique_ptr<adjacencyListBoost> sub_component = std::make_unique<adjacencyListBoost>(components[i].size());
-		sub_components[i] = std::move(sub_component);
+	//local ids in one pass, ascending within a component.
+	components.vertices.assign(num_components, index_map());
+	components.local_index.resize(graph.num_vertices);
+	for (int v = 0; v < graph.num_vertices; ++v) {
+		components.local_index[v] = static_cast<int>(components.vertices[component_map[v]].size());
+		components.vertices[component_map[v]].push_back(v);
 	}
 
 	//translate function.
-	for (size_t i = 0; i < boost::num_vertices(*graph); ++i) {
-		int component_i = component_map[i];
-		auto it_i = std::find(components[component_i].begin(), components[component_i].end(), i);
-		auto index_i = std::distance(components[component_i].begin(), it_i);
-		sub_newToOldIndex[component_i].insert({index_i,i});
-	}
-
-	//add all edges.
-	for (auto edge_iter = edges(*graph); edge_iter.first != edge_iter.second; ++edge_iter.first) {
-		auto u = source(*edge_iter.first, *graph);
-		auto v = target(*edge_iter.first, *graph);
-		int component_u = component_map[u];
-		int component_v = component_map[v];
-
-		if (component_u == component_v) {
-			auto it_u = std::find(components[component_u].begin(), components[component_u].end(), u);
-			auto it_v = std::find(components[component_v].begin(), components[component_v].end(), v);
-			auto index_u = std::distance(components[component_u].begin(), it_u);
-			auto index_v = std::distance(components[component_v].begin(), it_v);
-			boost::add_edge(index_u, index_v, *sub_components[component_u]);
-			//sub_newToOldIndex[component_u].insert({index_u,u});
-			//sub_newToOldIndex[component_v].insert({index_v,v});
-		} else {
-			throw std::runtime_error("Edge endpoints must always be in the same component.");
+	components.newToOldIndex.resize(num_components);
+	for (int c = 0; c < num_components; ++c) {
+		if (num_components > 1) {
+			Logger::num_vertices_components.push_back(components.vertices[c].size());
+		}
+		components.newToOldIndex[c] = components.vertices[c];
+		if (!relabelToOriginal.empty()) {
+			for (int& v : components.newToOldIndex[c]) {
+				v = relabelToOriginal[v];
+			}
 		}
 	}
 }
 
-adjacencyListBoost create_reduced_graph(MDS_CONTEXT& mds_context, std::unordered_map<int, int>& newToOldIndex) {
+MDS_CONTEXT create_component_context(const instance_components& components, int c) {
+	return MDS_CONTEXT(*components.graph, components.vertices[c], components.local_index);
+}
 
-	std::unordered_map<int, int> OldToNewIndex;
+void release_components(const std::string& path, std::unique_ptr<CSR_GRAPH>& instance, instance_components& components) {
+	components.graph = nullptr;
+	components.relabeled = CSR_GRAPH();
+	std::vector<index_map>().swap(components.vertices);
+	std::vector<int>().swap(components.local_index);
+	release_instance(path, instance);
+}
+
+adjacencyListBoost create_reduced_graph(MDS_CONTEXT& mds_context, index_map& newToOldIndex) {
 
-	auto [vert_itt, vert_itt_end] = boost::vertices(mds_context.graph);
+	//-1 for the vertices which are not in the reduced graph.
+	std::vector<int> OldToNewIndex(mds_context.get_total_vertices(), -1);
 
 	//fill newToOldIndex, this way we can find the original indexes after.
-	int newIndex = 0;
-	for (int oldIndex = 0; oldIndex < boost::num_vertices(mds_context.graph); ++oldIndex) {
+	newToOldIndex.clear();
+	for (int oldIndex = 0; oldIndex < mds_context.get_total_vertices(); ++oldIndex) {
 		if (!mds_context.is_selected(oldIndex) && !mds_context.is_removed(oldIndex)) {
-			newToOldIndex[newIndex] = oldIndex;
-			OldToNewIndex[oldIndex] = newIndex;
-			++newIndex;
+			OldToNewIndex[oldIndex] = static_cast<int>(newToOldIndex.size());
+			newToOldIndex.push_back(oldIndex);
 		}
 	}
 
 	//create the new graph with the updated number of vertices
-	adjacencyListBoost reduced_graph(OldToNewIndex.size());
+	adjacencyListBoost reduced_graph(newToOldIndex.size());
 
-	for (auto edge : make_iterator_range(mds_context.get_edge_itt())) {
-		int source = boost::source(edge, mds_context.graph);
-		int target = boost::target(edge, mds_context.graph);
+	for (auto edge : boost::make_iterator_range(mds_context.get_edge_itt())) {
+		int source = mds_context.get_source_edge(edge);
+		int target = mds_context.get_target_edge(edge);
 
 		//only add edges which both exists in the new graph. !(mds_context.is_dominated(source) & mds_context.is_dominated(target))
-		if (OldToNewIndex.count(source) && OldToNewIndex.count(target)) {
+		if (OldToNewIndex[source] >= 0 && OldToNewIndex[target] >= 0) {
 			// if (mds_context.is_excluded(source) && mds_context.is_excluded(target)) {
 			//
 			// } else
@@ -774,11 +918,29 @@ adjacencyListBoost create_reduced_graph(MDS_CONTEXT& mds_context, std::unordered
 }
 
 
-void component_reduction(std::string path)
+//vertices left for the solvers, the ones which are neither selected nor removed (as in create_reduced_graph).
+static std::vector<bool> get_reduced_vertices(MDS_CONTEXT& mds_context) {
+	std::vector<bool> keep(mds_context.get_total_vertices());
+	for (int v = 0; v < keep.size(); ++v) {
+		keep[v] = !mds_context.has_state(v, STATE_SELECTED | STATE_REMOVED);
+	}
+	return keep;
+}
+
+std::vector<SUBGRAPH_VIEW> create_reduced_component_views(MDS_CONTEXT& mds_context) {
+	return SUBGRAPH_VIEW::split_components(mds_context.get_graph(), get_reduced_vertices(mds_context));
+}
+
+SUBGRAPH_VIEW create_reduced_view(MDS_CONTEXT& mds_context) {
+	return SUBGRAPH_VIEW::induced(mds_context.get_graph(), get_reduced_vertices(mds_context));
+}
+
+bool component_reduction(std::string path)
 {
 	timer t_complete;
-	//create the original graph & context.
-	adjacencyListBoost adjLBoost = parse::load_pace_2024(path);
+	//create the original graph & context, the instance is kept to verify the solution.
+	const CSR_GRAPH instance = parse::load_pace_2024_csr(path);
+	adjacencyListBoost adjLBoost = parse::construct_AdjacencyList_Boost(instance);
 
 	//run reduction rules & fill the context.
 	MDS_CONTEXT mds_context = MDS_CONTEXT(adjLBoost);
@@ -786,7 +948,7 @@ void component_reduction(std::string path)
 	mds_context.fill_removed_vertex();
 
 	//Remove the unneeded vertices. (the reduced graph is 0 indexed so we have a map from new indicies and the old ones).
-	std::unordered_map<int, int> newToOldIndex;
+	index_map newToOldIndex;
 	adjacencyListBoost reduced_graph = create_reduced_graph(mds_context, newToOldIndex);
 
 
@@ -807,11 +969,14 @@ void component_reduction(std::string path)
 
 	//create empty sub-graphs + translation function.
 	std::vector<std::unique_ptr<adjacencyListBoost>> sub_components(num_components_reduced);
-	std::vector<std::unordered_map<int, int>> sub_newToOldIndex(num_components_reduced);
+	std::vector<index_map> sub_newToOldIndex(num_components_reduced);
 
 	for (size_t i = 0; i < components.size(); ++i) {
 		std::unique_ptr<adjacencyListBoost> sub_component = std::make_unique<adjacencyListBoost>(components[i].size());
 		sub_components[i] = std::move(sub_component);
+		for (int u : components[i]) {
+			sub_newToOldIndex[i].push_back(newToOldIndex[u]);
+		}
 	}
 
 	//add all edges.
@@ -827,8 +992,6 @@ void component_reduction(std::string path)
 			auto index_u = std::distance(components[component_u].begin(), it_u);
 			auto index_v = std::distance(components[component_v].begin(), it_v);
 			boost::add_edge(index_u, index_v, *sub_components[component_u]);
-			sub_newToOldIndex[component_u].insert({index_u,newToOldIndex[u]});
-			sub_newToOldIndex[component_v].insert({index_v,newToOldIndex[v]});
 		} else {
 			throw std::runtime_error("Edge endpoints must always be in the same component.");
 		}
@@ -836,7 +999,7 @@ void component_reduction(std::string path)
 	std::vector<int>solution;
 	for (int i = 0; i < sub_components.size(); ++i){
 		std::unique_ptr<NICE_TREE_DECOMPOSITION> nice_tree_decomposition = generate_td(*sub_components[i]);
-		std::unique_ptr<TREEWIDTH_SOLVER> td_comp = std::make_unique<TREEWIDTH_SOLVER>(std::move(nice_tree_decomposition), mds_context.dominated, mds_context.excluded, sub_newToOldIndex[i]);
+		std::unique_ptr<TREEWIDTH_SOLVER> td_comp = std::make_unique<TREEWIDTH_SOLVER>(std::move(nice_tree_decomposition), mds_context.get_state_vector(STATE_DOMINATED), mds_context.get_state_vector(STATE_EXCLUDED), sub_newToOldIndex[i]);
 
 		//generate final solution.
 		for (int newIndex : td_comp->global_solution) {
@@ -845,7 +1008,7 @@ void component_reduction(std::string path)
 		}
 	}
 
-	for (int i = 0; i < mds_context.selected.size(); ++i) {
+	for (int i = 0; i < mds_context.state.size(); ++i) {
 		if (mds_context.is_selected(i)) {
 			//we need a +1 te correct the previous -1.
 			solution.push_back(i + 1);
@@ -860,26 +1023,40 @@ void component_reduction(std::string path)
 	std::cout << t_complete.count() << std::endl;
 	std::cout << solution.size() << std::endl;
 	std::sort(solution.begin(), solution.end());
+	const bool valid = verify_solution(instance, solution);
 	parse::output_solution(solution, path);
+	return valid;
 }
 
-void separate_solver_treewidth(std::string path, strategy_reduction red_strategy, strategy_solver sol_strategy, strategy_reduction_scheme red_scheme_strategy, bool theory_strategy){
+bool separate_solver_treewidth(std::string path, strategy_reduction red_strategy, strategy_solver sol_strategy, strategy_reduction_scheme red_scheme_strategy, bool theory_strategy){
 	timer t_complete;
 	Logger::solver_strategy = sol_strategy;
 	Logger::reduction_strategy = red_strategy;
 	Logger::reduction_scheme_strategy = red_scheme_strategy;
 	//create empty sub-graphs + translation function.
-	std::vector<std::unique_ptr<adjacencyListBoost>> sub_components;
-	std::vector<std::unordered_map<int, int>> sub_newToOldIndex;
+	instance_components sub_components;
 
 	//Fill sub-graphs + translation function (no reduction).
-	create_component_subgraphs(path, sub_components, sub_newToOldIndex);
+	std::unique_ptr<CSR_GRAPH> instance = std::make_unique<CSR_GRAPH>(parse::load_pace_2024_csr(path));
+	create_component_subgraphs(path, instance, sub_components);
+	Logger::peak_rss_load = peak_rss_kb();
 	std::vector<int>solution;
 
+	//a precomputed decomposition (instance.td next to the instance) is used instead of htd where it fits.
+	std::unique_ptr<parse::td_file> precomputed_td;
+	if (std::filesystem::exists(parse::get_td_path(path))) {
+		precomputed_td = std::make_unique<parse::td_file>(parse::load_pace_td(parse::get_td_path(path)));
+	}
+
 	for (int i = 0; i < sub_components.size(); ++i){
 		//Create a mds_context & reduce. for each subgraph.
 		std::atomic<bool> stop_flag(false);
-		MDS_CONTEXT mds_context = MDS_CONTEXT(*sub_components[i]);
+		MDS_CONTEXT mds_context = create_component_context(sub_components, i);
+		//every component has its own context, the instance is not needed anymore.
+		if (i + 1 == sub_components.size()) {
+			release_components(path, instance, sub_components);
+		}
+		Logger::max_context_bytes = std::max(Logger::max_context_bytes, static_cast<long long>(mds_context.memory_bytes()));
 		timer t_reduction;
 		auto start = std::chrono::steady_clock::now();
 		auto timeout_duration = std::chrono::seconds(60);
@@ -887,33 +1064,34 @@ void separate_solver_treewidth(std::string path, strategy_reduction red_strategy
 
 		Logger::execution_time_reduction += t_reduction.count();
 		mds_context.fill_removed_vertex();
+		Logger::peak_rss_reduction = peak_rss_kb();
 
 		Logger::cnt_selected_vertices += mds_context.cnt_sel;
 		//Logger::cnt_excluded_vertices += mds_context.cnt_excl;
 		//Logger::cnt_ignored_vertices += mds_context.cnt_ign;
 		Logger::cnt_removed_vertices += mds_context.cnt_rem;
 
-		for (int v = 0; v < mds_context.selected.size(); ++v) {
+		TRANSLATION_CHAIN component_chain;
+		component_chain.push_layer(sub_components.newToOldIndex[i]);
+		for (int v = 0; v < mds_context.state.size(); ++v) {
 			if (mds_context.is_selected(v)) {
-				//we need a +1 te correct the previous -1.
-				solution.push_back(sub_newToOldIndex[i][v] + 1);
+				solution.push_back(component_chain.solution_vertex(v));
 			}
 		}
 
-		//Has reduction broke up a subgraph, into multiple sub-graphs.
-		std::vector<std::unique_ptr<adjacencyListBoost>> sub_sub_components;
-		std::vector<std::unordered_map<int, int>> sub_sub_newToOldIndex;
-
-		std::unordered_map<int, int> newToOldIndex;
-		adjacencyListBoost reduced_graph = create_reduced_graph(mds_context, newToOldIndex);
-		create_reduced_component_subgraphs(reduced_graph, sub_sub_components, sub_sub_newToOldIndex, newToOldIndex);
+		//Has reduction broke up a subgraph, into multiple sub-graphs (views of the graph of mds_context).
+		std::vector<SUBGRAPH_VIEW> component_views = create_reduced_component_views(mds_context);
 		//Solve each subgraph with a solver.
-		for (int j = 0; j < sub_sub_components.size(); ++j)
+		for (int j = 0; j < component_views.size(); ++j)
 		{
 
 			//get new MDS_CONTEXT.
-			MDS_CONTEXT mds_context_reduced = MDS_CONTEXT(*sub_sub_components[j]);
-			mds_context_reduced.fill_mds_context(mds_context, sub_sub_newToOldIndex[j]);
+			MDS_CONTEXT mds_context_reduced = MDS_CONTEXT(component_views[j]);
+			mds_context_reduced.fill_mds_context(mds_context, component_views[j].local_to_global());
+			//every view has been copied into its own context, the graph they point into is not needed anymore.
+			if (j + 1 == static_cast<int>(component_views.size())) {
+				mds_context.release_graph();
+			}
 
 			strategy_reduction strategy = REDUCTION_L_ALBER;
 			// std::future<void> l_reduction = std::async(std::launch::async, reduce::reduction_rule_manager, std::ref(mds_context_reduced), std::ref(strategy), 4, std::ref(stop_flag));
@@ -946,11 +1124,12 @@ void separate_solver_treewidth(std::string path, strategy_reduction red_strategy
 			//Logger::cnt_ignored_vertices += mds_context_reduced.cnt_ign;
 			Logger::cnt_removed_vertices += mds_context_reduced.cnt_rem;
 
-			std::unordered_map<int, int> newToOld;
-			for (int v = 0; v < mds_context_reduced.selected.size(); ++v) {
+			TRANSLATION_CHAIN chain;
+			chain.push_layer(sub_components.newToOldIndex[i]);
+			chain.push_layer(component_views[j].local_to_global());
+			for (int v = 0; v < mds_context_reduced.state.size(); ++v) {
 				if (mds_context_reduced.is_selected(v)) {
-					//we need a +1 te correct the previous -1.
-					solution.push_back(((sub_newToOldIndex[i][sub_sub_newToOldIndex[j][v]]) + 1));
+					solution.push_back(chain.solution_vertex(v));
 					Logger::cnt_selected_vertices++;
 					continue;
 				}
@@ -974,17 +1153,22 @@ void separate_solver_treewidth(std::string path, strategy_reduction red_strategy
 				}
 			}
 			//These reduction rules can cause components to subdivide into subcomponents so split them.
-			std::vector<std::unique_ptr<adjacencyListBoost>> sub_sub_sub_components;
-			std::vector<std::unordered_map<int, int>> sub_sub_sub_newToOldIndex;
+			std::vector<SUBGRAPH_VIEW> sub_component_views = create_reduced_component_views(mds_context_reduced);
 
-			adjacencyListBoost reduced_graph = create_reduced_graph(mds_context_reduced, newToOld);
-			create_reduced_component_subgraphs(reduced_graph, sub_sub_sub_components, sub_sub_sub_newToOldIndex, newToOld);
-
-			for (int q = 0; q < sub_sub_sub_newToOldIndex.size(); ++q) {
+			for (int q = 0; q < sub_component_views.size(); ++q) {
 				Logger::num_reduced_components++;
+				chain.push_layer(sub_component_views[q].local_to_global());
 				if (sol_strategy == SOLVER_NICE_TREE_DECOMPOSITION){
 				timer t_nice_tree_decomposition;
-				std::unique_ptr<NICE_TREE_DECOMPOSITION> nice_tree_decomposition = generate_td(*sub_sub_sub_components[q]);
+				std::unique_ptr<NICE_TREE_DECOMPOSITION> nice_tree_decomposition;
+				const CSR_GRAPH sub_component_csr = sub_component_views[q].to_csr();
+				if (precomputed_td) {
+					index_map newToOriginal = chain.compose();
+					nice_tree_decomposition = generate_td_precomputed(sub_component_csr, *precomputed_td, newToOriginal);
+				}
+				if (nice_tree_decomposition == nullptr) {
+					nice_tree_decomposition = generate_td(sub_component_csr);
+				}
 				if (nice_tree_decomposition)
 				{
 					Logger::treewidth.push_back(nice_tree_decomposition->treewidth);
@@ -997,55 +1181,58 @@ void separate_solver_treewidth(std::string path, strategy_reduction red_strategy
 			if (sol_strategy == SOLVER_TREEWIDTH)
 			{
 				timer t_treewidth;
-				std::unique_ptr<NICE_TREE_DECOMPOSITION> nice_tree_decomposition = generate_td(*sub_sub_sub_components[q]);
+				std::unique_ptr<NICE_TREE_DECOMPOSITION> nice_tree_decomposition;
+				const CSR_GRAPH sub_component_csr = sub_component_views[q].to_csr();
+				if (precomputed_td) {
+					index_map newToOriginal = chain.compose();
+					nice_tree_decomposition = generate_td_precomputed(sub_component_csr, *precomputed_td, newToOriginal);
+				}
+				if (nice_tree_decomposition == nullptr) {
+					nice_tree_decomposition = generate_td(sub_component_csr);
+				}
 				if (nice_tree_decomposition == nullptr)
 				{
 					throw std::runtime_error("tree decomposition is to big");
 				}
-				std::unique_ptr<TREEWIDTH_SOLVER> td_comp = std::make_unique<TREEWIDTH_SOLVER>(std::move(nice_tree_decomposition), mds_context_reduced.dominated, mds_context_reduced.excluded, sub_sub_sub_newToOldIndex[q]);
+				std::unique_ptr<TREEWIDTH_SOLVER> td_comp = std::make_unique<TREEWIDTH_SOLVER>(std::move(nice_tree_decomposition), mds_context_reduced.get_state_vector(STATE_DOMINATED), mds_context_reduced.get_state_vector(STATE_EXCLUDED), sub_component_views[q].local_to_global());
 
 				//generate final solution.
-				for (int newIndex : td_comp->global_solution) {
-					auto sub_index = sub_sub_newToOldIndex[j][sub_sub_sub_newToOldIndex[q][newIndex]];
-					solution.push_back((sub_newToOldIndex[i][sub_index]) + 1);
-				}
+				chain.lift(td_comp->global_solution, solution);
 				Logger::execution_time_treewidth += t_treewidth.count();
 			}
 			else if (sol_strategy == SOLVER_ILP) {
 				timer t_ilp;
-				std::vector<int> partial_solution = operations_research::ilp_solver(mds_context_reduced, *sub_sub_sub_components[q], sub_sub_sub_newToOldIndex[q]);
+				std::vector<int> partial_solution = operations_research::ilp_solver(mds_context_reduced, sub_component_views[q]);
 
-				for (int newIndex : partial_solution) {
-					auto sub_index = sub_sub_newToOldIndex[j][sub_sub_sub_newToOldIndex[q][newIndex]];
-					solution.push_back((sub_newToOldIndex[i][sub_index]) + 1);
-				}
+				chain.lift(partial_solution, solution);
 				Logger::execution_time_ilp += t_ilp.count();
 			}
 			else if (sol_strategy == SOLVER_SAT) {
 				timer t_sat;
-				std::vector<int> partial_solution = sat_solver_dominating_set(mds_context_reduced, *sub_sub_sub_components[q], sub_sub_sub_newToOldIndex[q]);
+				std::vector<int> partial_solution = sat_solver_dominating_set(mds_context_reduced, sub_component_views[q]);
 
-				for (int newIndex : partial_solution) {
-					auto sub_index = sub_sub_newToOldIndex[j][sub_sub_sub_newToOldIndex[q][newIndex]];
-					solution.push_back((sub_newToOldIndex[i][sub_index]) + 1);
-				}
+				chain.lift(partial_solution, solution);
 				Logger::execution_time_sat += t_sat.count();
 				//Logger::average_SAT_execution_time.push_back(t_sat.count());
 			}
+				chain.pop_layer();
 			}
 
 
 
 		}
 	}
+	Logger::peak_rss_solver = peak_rss_kb();
 	Logger::domination_number = solution.size();
 	std::cout << solution.size() << std::endl;
 	Logger::execution_time_complete = t_complete.count();
 	std::cout << Logger::execution_time_complete << std::endl;
 	Logger::average_SAT_execution_time.push_back(Logger::execution_time_sat);
+	const bool valid = verify_solution(path, instance, solution);
 	parse::output_solution(solution, path);
 	std::string name = parse::getNameFile(path);
 	output_loginfo(name);
+	return valid;
 }
 	
 
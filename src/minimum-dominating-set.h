@@ -4,35 +4,68 @@
 #pragma once
 #include "graph/graph_io.h"
 #include "graph/context.h"
+#include "graph/translation_chain.h"
 #include "reduce.h"
 
 int main(int argc, char* argv[]);
 
-void dominating_set_solver(std::string path);
+bool dominating_set_solver(std::string path);
 
 void reduction_info(std::string path);
 
-void separate_solver_treewidth(std::string path, strategy_reduction red_strategy, strategy_solver sol_strategy, strategy_reduction_scheme red_scheme_strategy, bool theory_strategy);
+bool separate_solver_treewidth(std::string path, strategy_reduction red_strategy, strategy_solver sol_strategy, strategy_reduction_scheme red_scheme_strategy, bool theory_strategy);
 
 void reduction(std::string path, std::string path_td);
 
 void output_reduced_graph(std::string path);
 
-adjacencyListBoost create_reduced_graph(MDS_CONTEXT& mds_context, std::unordered_map<int, int>& newToOldIndex);
+adjacencyListBoost create_reduced_graph(MDS_CONTEXT& mds_context, index_map& newToOldIndex);
 
-void separate_solver(std::string path, strategy_reduction red_strategy, strategy_solver sol_strategy, strategy_reduction_scheme red_scheme_strategy, bool theory_strategy);
+std::vector<SUBGRAPH_VIEW> create_reduced_component_views(MDS_CONTEXT& mds_context);
 
-void seperate_solver_no_components(std::string path, strategy_reduction red_strategy, strategy_solver sol_strategy);
+SUBGRAPH_VIEW create_reduced_view(MDS_CONTEXT& mds_context);
 
-void component_reduction(std::string path);
+bool separate_solver(std::string path, strategy_reduction red_strategy, strategy_solver sol_strategy, strategy_reduction_scheme red_scheme_strategy, bool theory_strategy);
 
-void create_reduced_component_subgraphs(adjacencyListBoost& reduced_graph,
-                                        std::vector<std::unique_ptr<adjacencyListBoost>>& sub_sub_components,
-                                        std::vector<std::unordered_map<int, int>>& sub_sub_newToOldIndex,
-                                        std::unordered_map<int, int>& newToOldIndex);
+bool seperate_solver_no_components(std::string path, strategy_reduction red_strategy, strategy_solver sol_strategy);
 
-void create_component_subgraphs(const std::string& path,
-                                std::vector<std::unique_ptr<adjacencyListBoost>>& sub_components,
-                                std::vector<std::unordered_map<int, int>>& sub_newToOldIndex);
+bool component_reduction(std::string path);
+
+void export_kernel(std::string path, std::string kernel_path, strategy_reduction red_strategy, bool theory_strategy);
+
+//sat, ilp or treewidth, any other strategy is rejected.
+bool solve_kernel(std::string kernel_path, strategy_solver sol_strategy);
+
+//the solvers return whether the solution they wrote is a dominating set of the instance (checked with verify_solution).
+
+//checks the solution (1 indexed) against the instance as it was loaded.
+bool verify_solution(const CSR_GRAPH& instance, std::vector<int>& solution);
+
+//after the instance is split into components it is only kept if it can not be read a second time (stdin, pipes),
+//so the solvers do not hold it next to their own graphs. Logger::instance_kept reports which case it was.
+void release_instance(const std::string& path, std::unique_ptr<CSR_GRAPH>& instance);
+
+//verifies against the kept instance, or loads the instance again if release_instance released it.
+bool verify_solution(const std::string& path, std::unique_ptr<CSR_GRAPH>& instance, std::vector<int>& solution);
+
+//connected components of the instance (in the order of their smallest vertex). the component graphs are not built,
+//create_component_context builds the MDS_CONTEXT of a component from its neighborhoods in graph.
+struct instance_components {
+    CSR_GRAPH relabeled;                  // the relabeled instance, empty for RELABEL_NON.
+    const CSR_GRAPH* graph = nullptr;     // the relabeled instance or the instance, nullptr after release_components.
+    std::vector<index_map> vertices;      // vertices[c]: the vertices of component c in graph, ascending.
+    std::vector<index_map> newToOldIndex; // newToOldIndex[c]: translates the vertices of component c to the instance.
+    std::vector<int> local_index;         // local_index[v]: the vertex of v (of graph) in its component.
+
+    int size() const { return static_cast<int>(newToOldIndex.size()); }
+};
+
+//a relabeled instance is not needed by the components, then it is released right away (release_instance).
+void create_component_subgraphs(const std::string& path, std::unique_ptr<CSR_GRAPH>& instance, instance_components& components);
+
+MDS_CONTEXT create_component_context(const instance_components& components, int c);
+
+//once the context of the last component is built: the components only keep newToOldIndex, the instance is released.
+void release_components(const std::string& path, std::unique_ptr<CSR_GRAPH>& instance, instance_components& components);
 
 // TODO: Reference additional headers your program requires here.
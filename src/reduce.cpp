@@ -3,11 +3,14 @@
 #include <boost/graph/graph_traits.hpp>
 #include <boost/graph/adjacency_list.hpp>
 #include <algorithm>
+#include <iterator>
 #include <iostream>
-#include <queue>
 #include <absl/strings/str_format.h>
 #include <atomic>
+#include "graph/candidate_pairs.h"
+#include "util/local_index.h"
 #include "util/logger.h"
+#include "util/parallel.h"
 
 #include "absl/strings/internal/str_format/extension.h"
 #include "util/timer.h"
@@ -15,6 +18,62 @@
 
 
 namespace reduce {
+	//lookup tables of the neighborhood rules (exit, guard and prison partitions), one set per thread.
+	//clearing them is O(1), so a rule only pays for the neighborhood it looks at.
+	struct neighborhood_scratch {
+		EPOCH_MARKER lookup;      // N[u], N[v] + N[w] or N[l_vertices].
+		EPOCH_MARKER exit;        // the exit vertices.
+		EPOCH_MARKER guard;       // the guard vertices.
+		EPOCH_MARKER domination;  // number of undominated prison vertices a vertex dominates.
+		EPOCH_MARKER visited;     // bfs of the distance 3 candidates.
+		std::vector<std::pair<vertex, int>> queue;
+		LOCAL_INDEX candidate_id;           // l rule: the vertices of the (alternative) dominations.
+		LOCAL_INDEX closed_neighborhood_id; // l rule: N[l_vertices].
+	};
+
+	static neighborhood_scratch& get_scratch() {
+		thread_local neighborhood_scratch scratch;
+		return scratch;
+	}
+
+	//coverage[candidate_id.id(u)] gets bit j for every candidate u in N[undominated[j]].
+	static void get_coverage(MDS_CONTEXT& mds_context, std::vector<int>& undominated, LOCAL_INDEX& candidate_id, std::vector<boost::dynamic_bitset<>>& coverage) {
+		for (std::size_t j = 0; j < undominated.size(); ++j) {
+			int id = candidate_id.id(undominated[j]);
+			if (id >= 0) {
+				coverage[id][j] = true;
+			}
+			auto [neigh_itt, neigh_itt_end] = mds_context.get_neighborhood_itt(undominated[j]);
+			for (; neigh_itt < neigh_itt_end; ++neigh_itt) {
+				id = candidate_id.id(*neigh_itt);
+				if (id >= 0) {
+					coverage[id][j] = true;
+				}
+			}
+		}
+	}
+
+	//sets the bits of N[v] in neighborhood (over the ids of local), false if a vertex of N[v] has no id.
+	static bool get_closed_neighborhood(MDS_CONTEXT& mds_context, vertex v, LOCAL_INDEX& local, boost::dynamic_bitset<>& neighborhood) {
+		bool inside = true;
+		int id = local.id(v);
+		if (id >= 0) {
+			neighborhood[id] = true;
+		} else {
+			inside = false;
+		}
+		auto [neigh_itt, neigh_itt_end] = mds_context.get_neighborhood_itt(v);
+		for (; neigh_itt < neigh_itt_end; ++neigh_itt) {
+			id = local.id(*neigh_itt);
+			if (id >= 0) {
+				neighborhood[id] = true;
+			} else {
+				inside = false;
+			}
+		}
+		return inside;
+	}
+
 	void reduction_rule_manager(MDS_CONTEXT& mds_context, strategy_reduction& strategy, int l, bool theory_strategy, std::chrono::time_point<std::chrono::steady_clock> start, std::chrono::seconds timeout_duration) {
 		if (std::chrono::steady_clock::now() - start > timeout_duration){
 			return;
@@ -43,57 +102,65 @@ namespace reduce {
 		auto [vert_itt, vert_itt_end] = mds_context.get_vertices_itt();
 		bool first_time = run_rule_2;
 		int cnt_reductions;
+		//vertices added by the rules are not visited (vert_itt_end is taken once).
+		const int num_vertices = *vert_itt_end;
+		//the simple rules and rule 1 are swept separately, after the first round only the vertices near the changes are visited again.
+		WORKLIST worklist(mds_context, 2, num_vertices);
+		//the candidates of the pair rule are only searched again after a change near them.
+		CANDIDATE_PAIRS candidate_pairs(mds_context);
 		do {
 			//reset counter
 			cnt_reductions = 0;
-
-			//the first time bool only gets false if, reduce_neigh_pair gets called.
-			if (!first_time) {
-				auto [vert_itt, vert_itt_end] = mds_context.get_vertices_itt();
-			}
-
-			for (auto vertex = vert_itt; vertex < vert_itt_end; ++vertex) {
-				//simple reduction rules.
-				if (mds_context.is_removed(*vertex)) {
+			//no iterator over the graph is alive here, drop the dead edges once they dominate the neighborhoods.
+			mds_context.graph.maybe_compact();
+
+			//the sweeps visit the dirty vertices in ascending order, the state is checked when a vertex is visited.
+			//simple reduction rules.
+			worklist.start_sweep(0);
+			for (int v; worklist.next(0, v);) {
+				if (mds_context.is_removed(v) || !mds_context.is_dominated(v)) {
 					continue;
 				}
-				if (mds_context.is_dominated(*vertex)) {
-					if (simple_rule_one(mds_context, *vertex)) {
-						Logger::cnt_alber_simple_rule_1++;
-						++cnt_reductions;
-					}
-					if (simple_rule_two(mds_context, *vertex)) {
-						Logger::cnt_alber_simple_rule_2++;
-						++cnt_reductions;
-					}
-					if (simple_rule_three(mds_context, *vertex)) {
-						++cnt_reductions;
-					}
-					if (simple_rule_four(mds_context, *vertex)) {
-						Logger::cnt_alber_simple_rule_4++;
-						++cnt_reductions;
-					}
+				if (simple_rule_one(mds_context, v)) {
+					Logger::cnt_alber_simple_rule_1++;
+					++cnt_reductions;
+				}
+				if (simple_rule_two(mds_context, v)) {
+					Logger::cnt_alber_simple_rule_2++;
+					++cnt_reductions;
+				}
+				if (simple_rule_three(mds_context, v)) {
+					++cnt_reductions;
+				}
+				if (simple_rule_four(mds_context, v)) {
+					Logger::cnt_alber_simple_rule_4++;
+					++cnt_reductions;
 				}
 			}
-			for (auto vertex = vert_itt; vertex < vert_itt_end; ++vertex) {
-				if (!mds_context.is_excluded(*vertex) && !mds_context.is_removed(*vertex)) { // if removed is checked above.
-					if (reduce_neighborhood_single_vertex(mds_context, *vertex)) {
+			worklist.start_sweep(1);
+			for (int v; worklist.next(1, v);) {
+				if (!mds_context.is_excluded(v) && !mds_context.is_removed(v)) {
+					if (reduce_neighborhood_single_vertex(mds_context, v)) {
 						++cnt_reductions;
 					}
 				}
 			}
 			if (cnt_reductions == 0 && first_time) {
-				for (auto itt = vert_itt; itt < vert_itt_end; ++itt) {
-					if (!mds_context.is_undetermined(*itt)) {
+				for (vertex v : mds_context.get_vertices()) {
+					if (v >= static_cast<vertex>(num_vertices)) {
+						break;
+					}
+					if (!mds_context.is_undetermined(v)) {
 						continue;
 					}
 
-					auto possible_combinations = bfs_get_distance_three(mds_context, *itt);
-					for (vertex poss : possible_combinations) {
+					auto [poss_itt, poss_itt_end] = candidate_pairs.get_candidates(v);
+					for (; poss_itt < poss_itt_end; ++poss_itt) {
+						vertex poss = *poss_itt;
 						if (mds_context.is_undetermined(poss)) {
-							if (*itt < poss)
+							if (v < poss)
 							{
-								if (reduce_neighborhood_pair_vertices(mds_context, *itt, poss)) {
+								if (reduce_neighborhood_pair_vertices(mds_context, v, poss)) {
 									++cnt_reductions;
 								}
 							}
@@ -108,29 +175,38 @@ namespace reduce {
 		bool reduced;
 		auto [vertex_itt, vertex_itt_end] = mds_context.get_vertices_itt();
 		bool first_time = run_rule_2;
+		//after the first sweep only the vertices near the changes are visited again.
+		WORKLIST worklist(mds_context, 1, -1);
+		//the candidates of the pair rule are only searched again after a change near them.
+		CANDIDATE_PAIRS candidate_pairs(mds_context);
 
 		do {
 			reduced = false;
-			auto [vertex_itt, vertex_itt_end] = mds_context.get_vertices_itt();
-			for (auto itt = vertex_itt; itt < vertex_itt_end; ++itt) {
+			mds_context.graph.maybe_compact();
+			//the rules only apply to undetermined or undominated vertices, the state is checked when a vertex is visited.
+			worklist.start_sweep(0);
+			for (int v; worklist.next(0, v);) {
 				if (std::chrono::steady_clock::now() - start > timeout_duration){
 					return;
 				}
-				if (mds_context.is_undetermined(*itt)) {
+				if (!mds_context.undetermined_set.contains(v) && !mds_context.undominated_set.contains(v)) {
+					continue;
+				}
+				if (mds_context.is_undetermined(v)) {
 					Logger::attempt_ijcai_rule_1++;
-					reduced |= reduce_subset(mds_context,*itt);
+					reduced |= reduce_subset(mds_context, v);
 				}
-				if (!mds_context.is_dominated_ijcai(*itt)) {
+				if (!mds_context.is_dominated_ijcai(v)) {
 					Logger::attempt_ijcai_rule_2++;
-					bool temp = reduce_single_dominator(mds_context, *itt);
+					bool temp = reduce_single_dominator(mds_context, v);
 					reduced |= temp;
 					if (temp){
 						Logger::cnt_ijcai_rule_2++;
 					}
 				}
-				if (!mds_context.is_dominated_ijcai(*itt)) {
+				if (!mds_context.is_dominated_ijcai(v)) {
 					Logger::attempt_ijcai_rule_3++;
-					bool temp = reduce_ignore(mds_context, *itt);
+					bool temp = reduce_ignore(mds_context, v);
 					reduced |= temp;
 					if (temp){
 						Logger::cnt_ijcai_rule_3++;
@@ -138,6 +214,7 @@ namespace reduce {
 				}
 			}
 			if ((!reduced && first_time)) {
+				candidate_pairs.build(available_threads());
 				bool reduction_found = true;
 				while (reduction_found)
 				{
@@ -151,8 +228,9 @@ namespace reduce {
 						if (!mds_context.is_undetermined(*itt)) {
 							continue;
 						}
-						auto possible_combinations = bfs_get_distance_three(mds_context, *itt);
-						for (vertex poss : possible_combinations) {
+						auto [poss_itt, poss_itt_end] = candidate_pairs.get_candidates(*itt);
+						for (; poss_itt < poss_itt_end; ++poss_itt) {
+							vertex poss = *poss_itt;
 							if (mds_context.is_undetermined(poss)) {
 								if (*itt < poss) {
 									reduced |= reduce_neighborhood_pair_vertices_ijcai(mds_context, *itt, poss);
@@ -171,6 +249,9 @@ namespace reduce {
 	void reduce_l_alber(MDS_CONTEXT& mds_context, int l, bool theory_strategy, std::chrono::time_point<std::chrono::steady_clock> start, std::chrono::seconds timeout_duration){
 		bool reduction = true;
 		auto [first_vert_itt, first_vert_itt_end] = mds_context.get_vertices_itt();
+		const int first_num_vertices = *first_vert_itt_end;
+		//dirty vertices of the simple rules, after a successful l rule only the vertices near its changes are visited again.
+		WORKLIST worklist(mds_context, 1, -1);
 		bool simple_reduce = true;
 		while (simple_reduce)
 		{
@@ -178,23 +259,27 @@ namespace reduce {
 			if (std::chrono::steady_clock::now() - start > timeout_duration){
 				return;
 			}
-			for (auto first_vertex = first_vert_itt; first_vertex < first_vert_itt_end; ++first_vertex)
+			worklist.start_sweep(0);
+			for (int first_vertex; worklist.next(0, first_vertex);)
 			{
+				if (first_vertex >= first_num_vertices) {
+					continue;
+				}
 				//simple reduction rules.
-				if (mds_context.is_removed(*first_vertex) || (mds_context.is_dominated(*first_vertex) && mds_context.is_excluded(*first_vertex))) {
+				if (mds_context.is_removed(first_vertex) || (mds_context.is_dominated(first_vertex) && mds_context.is_excluded(first_vertex))) {
 					continue;
 				}
-				if (mds_context.is_dominated(*first_vertex)) {
-					if (simple_rule_one(mds_context, *first_vertex)) {
+				if (mds_context.is_dominated(first_vertex)) {
+					if (simple_rule_one(mds_context, first_vertex)) {
 						simple_reduce = true;
 					}
-					if (simple_rule_two(mds_context, *first_vertex)) {
+					if (simple_rule_two(mds_context, first_vertex)) {
 						simple_reduce = true;
 					}
-					if (simple_rule_three(mds_context, *first_vertex)) {
+					if (simple_rule_three(mds_context, first_vertex)) {
 						simple_reduce = true;
 					}
-					if (simple_rule_four(mds_context, *first_vertex)) {
+					if (simple_rule_four(mds_context, first_vertex)) {
 						simple_reduce = true;
 					}
 				}
@@ -204,14 +289,14 @@ namespace reduce {
 		{
 			//boost::unordered_set<std::vector<int>> done;
 			reduction = false;
-			auto [vert_it, vert_it_end] = mds_context.get_vertices_itt();
-			for (;vert_it != vert_it_end; ++vert_it) {
+			std::vector<vertex> undetermined = mds_context.get_vertices();
+			for (auto vert_it = undetermined.begin(); vert_it != undetermined.end(); ++vert_it) {
 				if (std::chrono::steady_clock::now() - start > timeout_duration){
 					return;
 				}
 				if (mds_context.is_undetermined(*vert_it)) {
 					//std::cout << "iteration: " << counter << std::endl;
-					reduction |= execute_l_alber(mds_context, l, 1, { static_cast<int>(*vert_it) });
+					reduction |= execute_l_alber(mds_context, worklist, l, 1, { static_cast<int>(*vert_it) });
 					//execute_l_alber_two(mds_context, l, *vert_it);
 				}
 			}
@@ -237,7 +322,7 @@ namespace reduce {
 		 			return;
 		 		}
 		 		if (mds_context.is_undetermined(*vert_it)) {
-		 			bool succes = execute_l_alber(mds_context, smaller_l, 1, { static_cast<int>(*vert_it) });
+		 			bool succes = execute_l_alber(mds_context, worklist, smaller_l, 1, { static_cast<int>(*vert_it) });
 		 			reduction_smaller |= succes;
 		 			if (succes) {
 		 				found_a_reduction = true;
@@ -373,7 +458,7 @@ namespace reduce {
 		return false; // no duplicates
 	}
 
-	bool execute_l_alber(MDS_CONTEXT& mds_context, int l, int counter, std::vector<int> vertices){
+	bool execute_l_alber(MDS_CONTEXT& mds_context, WORKLIST& worklist, int l, int counter, std::vector<int> vertices){
 		if (l == counter){
 			//std::sort(vertices.begin(), vertices.end());
 			//if (done.find(vertices) == done.end())
@@ -382,30 +467,31 @@ namespace reduce {
 				Logger::attempt_alber_l_reduction++;
 				bool reduction = reduction_l_rule(mds_context, vertices);
 				if (reduction){
+					//the simple rules were exhausted before, so only the vertices near the changes of the l rule can reduce.
 					bool simple_reduction = true;
 					while (simple_reduction)
 					{
 						simple_reduction = false;
-						auto [vert_itt, vert_itt_end] = mds_context.get_vertices_itt();
-						for (auto vertex = vert_itt; vertex < vert_itt_end; ++vertex)
+						worklist.start_sweep(0);
+						for (int vertex; worklist.next(0, vertex);)
 						{
 							//simple reduction rules.
-							if (mds_context.is_removed(*vertex) || (mds_context.is_dominated(*vertex) && mds_context.is_excluded(*vertex))) {
+							if (mds_context.is_removed(vertex) || (mds_context.is_dominated(vertex) && mds_context.is_excluded(vertex))) {
 								continue;
 							}
-							if (mds_context.is_dominated(*vertex)) {
-								if (simple_rule_one(mds_context, *vertex)) {
+							if (mds_context.is_dominated(vertex)) {
+								if (simple_rule_one(mds_context, vertex)) {
 									Logger::cnt_alber_simple_rule_1++;
 									simple_reduction = true;
 								}
-								if (simple_rule_two(mds_context, *vertex)) {
+								if (simple_rule_two(mds_context, vertex)) {
 									Logger::cnt_alber_simple_rule_2++;
 									simple_reduction = true;
 								}
-								if (simple_rule_three(mds_context, *vertex)) {
+								if (simple_rule_three(mds_context, vertex)) {
 									simple_reduction = true;
 								}
-								if (simple_rule_four(mds_context, *vertex)) {
+								if (simple_rule_four(mds_context, vertex)) {
 									Logger::cnt_alber_simple_rule_4++;
 									simple_reduction = true;
 								}
@@ -433,7 +519,7 @@ namespace reduce {
 					is_biggest = false;
 				}
 				if (is_biggest){
-					reduced |= execute_l_alber(mds_context, l, counter + 1, updated_vertices);
+					reduced |= execute_l_alber(mds_context, worklist, l, counter + 1, updated_vertices);
 				}
 				// if (*std::min_element(updated_vertices.begin(), updated_vertices.end()) == vtx){
 				// // 	std::cout << vtx << std::endl;
@@ -465,33 +551,35 @@ namespace reduce {
 
 
 	std::vector<vertex> bfs_get_distance_three_generalized(MDS_CONTEXT& mds_context, std::vector<int>& vertices) {
-		std::unordered_set<vertex> visited;
+		neighborhood_scratch& scratch = get_scratch();
+		EPOCH_MARKER& visited = scratch.visited;
+		std::vector<std::pair<vertex, int>>& queue = scratch.queue;
 		std::vector<vertex> within_distance_three;
-		std::queue<std::pair<vertex,int>> queue;
+		visited.clear(mds_context.get_total_vertices());
+		queue.clear();
 
 		for (auto& v : vertices) {
 			visited.insert(v);
-			queue.emplace(v,0);
+			queue.emplace_back(v,0);
 		}
-		//queue.emplace(vertices[0],0);
-
-		while (!queue.empty()){
-			auto [current, depth] = queue.front();
-			queue.pop();
 
-			if (depth >= 3) continue;
+		for (std::size_t head = 0; head < queue.size(); ++head) {
+			auto [current, depth] = queue[head];
 
 			auto [neigh_it, neigh_end] = mds_context.get_neighborhood_itt(current);
 			for (; neigh_it < neigh_end; ++neigh_it) {
 				vertex neighbor = *neigh_it;
 
-				if (!visited.count(neighbor)){
+				if (!visited.contains(neighbor)){
 					visited.insert(neighbor);
 					if (mds_context.is_undetermined(neighbor))
 					{
 						within_distance_three.push_back(neighbor);
 					}
-					queue.emplace(neighbor,depth+1);
+					//the neighborhoods at distance 3 are not searched.
+					if (depth + 1 < 3) {
+						queue.emplace_back(neighbor,depth+1);
+					}
 				}
 			}
 		}
@@ -501,18 +589,18 @@ namespace reduce {
 	}
 
 	std::vector<vertex> bfs_get_distance_three(MDS_CONTEXT& mds_context, vertex v){
-		std::unordered_set<vertex> visited;
+		neighborhood_scratch& scratch = get_scratch();
+		EPOCH_MARKER& visited = scratch.visited;
+		std::vector<std::pair<vertex, int>>& queue = scratch.queue;
 		std::vector<vertex> within_distance_three;
-		std::queue<std::pair<vertex,int>> queue;
+		visited.clear(mds_context.get_total_vertices());
+		queue.clear();
 
 		visited.insert(v);
-		queue.emplace(v,0);
-
-		while (!queue.empty()){
-			auto [current, depth] = queue.front();
-			queue.pop();
+		queue.emplace_back(v,0);
 
-			if (depth == 3) continue;
+		for (std::size_t head = 0; head < queue.size(); ++head) {
+			auto [current, depth] = queue[head];
 
 			auto [neigh_it, neigh_end] = mds_context.get_neighborhood_itt(current);
 			for (; neigh_it < neigh_end; ++neigh_it) {
@@ -520,12 +608,14 @@ namespace reduce {
 				if (mds_context.is_excluded(neighbor) && mds_context.is_dominated(neighbor)) {
 					continue;
 				}
-				if (!visited.count(neighbor)){
+				if (!visited.contains(neighbor)){
 					visited.insert(neighbor);
 					if (mds_context.is_undetermined(neighbor)){
 						within_distance_three.push_back(neighbor);
 					}
-					queue.emplace(neighbor,depth+1);
+					if (depth + 1 < 3) {
+						queue.emplace_back(neighbor,depth+1);
+					}
 				}
 			}
 		}
@@ -541,23 +631,30 @@ namespace reduce {
 
 		//create neighborhood lookup table
 		int num_vertices = mds_context.get_total_vertices();
-		std::vector<int>lookup = std::vector<int>(num_vertices, 0);
-		lookup[u] = 1;
+		neighborhood_scratch& scratch = get_scratch();
+		EPOCH_MARKER& lookup = scratch.lookup;
+		lookup.clear(num_vertices);
+		lookup.insert(u);
 		for (auto v = neigh_itt_u; v < neigh_itt_u_end; ++v) {
-			lookup[*v] = 1;
+			lookup.insert(*v);
 		}
 
-		std::unordered_set<int>exit_vertices; //N_{3}
+		std::vector<int>exit_vertices; //N_{3}
 		std::vector<int>guard_vertices; //N_{2}
 		std::vector<int>prison_vertices; //N_{1}
+		EPOCH_MARKER& is_exit = scratch.exit;
+		is_exit.clear(num_vertices);
 
 		for (auto v = neigh_itt_u; v < neigh_itt_u_end; ++v) {
 			//for each vertex v get the neighborhood.
 			auto [neigh_itt_v, neigh_itt_v_end] = mds_context.get_neighborhood_itt(*v);
 			for (; neigh_itt_v < neigh_itt_v_end; ++neigh_itt_v) {
 				//If there is at least 1 neighbor is not within the neighborhood of u. It becomes a exit vertex.
-				if (lookup[*neigh_itt_v] == 0) {
-					exit_vertices.insert(*v);
+				if (!lookup.contains(*neigh_itt_v)) {
+					if (!is_exit.contains(*v)) {
+						is_exit.insert(*v);
+						exit_vertices.push_back(*v);
+					}
 					break;
 				}
 			}
@@ -565,14 +662,14 @@ namespace reduce {
 		//Identify if remaining vertices go into guard_vertices or prison_vertices.
 		for (auto v = neigh_itt_u; v < neigh_itt_u_end; ++v) {
 			//check if vertex is not a exit_vertex.
-			if (exit_vertices.count(*v)) {
+			if (is_exit.contains(*v)) {
 				continue;
 			}
 			bool guard_trigger = false;
 			auto [neigh_itt_v, neigh_itt_v_end] = mds_context.get_neighborhood_itt(*v);
 			for (;neigh_itt_v < neigh_itt_v_end; ++neigh_itt_v) {
 				//Check if it is a guard_vertex.
-				if (exit_vertices.count(*neigh_itt_v)) {
+				if (is_exit.contains(*neigh_itt_v)) {
 					guard_vertices.push_back(*v);
 					guard_trigger = true;
 					break;
@@ -621,12 +718,18 @@ namespace reduce {
 				return false;
 			}
 			// get adjacency lookup table & itteratable list of all neighbors of v & w (lookup includes v&w while itt. excludes them).
-			auto [lookup, pair_neighborhood_vector] = mds_context.get_pair_neighborhood(v, w);
+			neighborhood_scratch& scratch = get_scratch();
+			EPOCH_MARKER& lookup = scratch.lookup;
+			std::vector<vertex> pair_neighborhood_vector = mds_context.get_pair_neighborhood(v, w, lookup);
 
 			// partition neighborhood u into 3 sets.
 			std::vector<int>exit_vertices; //N_{3}
 			std::vector<int>guard_vertices; //N_{2}
 			std::vector<int>prison_vertices; //N_{1}
+			EPOCH_MARKER& is_exit = scratch.exit;
+			EPOCH_MARKER& is_guard = scratch.guard;
+			is_exit.clear(mds_context.get_total_vertices());
+			is_guard.clear(mds_context.get_total_vertices());
 
 			//Identify exit_vertices
 			for (auto u = pair_neighborhood_vector.begin(); u < pair_neighborhood_vector.end(); ++u) {
@@ -634,8 +737,9 @@ namespace reduce {
 				auto [neigh_itt_u, neigh_itt_u_end] = mds_context.get_neighborhood_itt(*u);
 				//if ANY neighbor isn't in lookup (it belongs to exit_vertices).
 				for (;neigh_itt_u < neigh_itt_u_end; ++neigh_itt_u) {
-					if (lookup[*neigh_itt_u] == 0) {
+					if (!lookup.contains(*neigh_itt_u)) {
 						exit_vertices.push_back(*u);
+						is_exit.insert(*u);
 						break;
 					}
 				}
@@ -643,7 +747,7 @@ namespace reduce {
 			//divide all non N_exit vertices into N_guard and N_prison. (could be abstracted).
 			for (auto u = pair_neighborhood_vector.begin(); u < pair_neighborhood_vector.end(); ++u) {
 				//check if vertex is not a exit_vertex.
-				if (std::find(exit_vertices.begin(), exit_vertices.end(), *u) != exit_vertices.end()) {
+				if (is_exit.contains(*u)) {
 					continue;
 				}
 				else {
@@ -652,8 +756,9 @@ namespace reduce {
 					auto [neigh_itt_u, neigh_itt_u_end] = mds_context.get_neighborhood_itt(*u);
 					for (;neigh_itt_u < neigh_itt_u_end; ++neigh_itt_u) {
 						//Check if it is a guard_vertex.
-						if (std::find(exit_vertices.begin(), exit_vertices.end(), *neigh_itt_u) != exit_vertices.end()) {
+						if (is_exit.contains(*neigh_itt_u)) {
 							guard_vertices.push_back(*u);
+							is_guard.insert(*u);
 							guard_trigger = true;
 							break;
 						}
@@ -668,7 +773,7 @@ namespace reduce {
 			//find the subset of undominated N_prison vertices.
 			std::vector<int>undominated_prison_vertices;
 			for (auto i = prison_vertices.begin(); i < prison_vertices.end(); ++i) {
-				if (mds_context.dominated[*i] == 0) {
+				if (!mds_context.is_dominated(*i)) {
 					undominated_prison_vertices.push_back(*i);
 				}
 			}
@@ -677,30 +782,31 @@ namespace reduce {
 				int size = undominated_prison_vertices.size();
 				//create domination table. (how many vertices of undominated_prison_vertices can a vertex dominate).
 				int num_vertices = mds_context.get_total_vertices();
-				std::vector<int>domination = std::vector<int>(num_vertices, 0);
+				EPOCH_MARKER& domination = scratch.domination;
+				domination.clear(num_vertices);
 				for (auto i = undominated_prison_vertices.begin(); i < undominated_prison_vertices.end(); ++i) {
-					domination[*i]++; //dominate himself.
+					domination.increment(*i); //dominate himself.
 					auto [edge_itt, edge_itt_end] = mds_context.get_neighborhood_itt(*i);
 					for (;edge_itt, edge_itt < edge_itt_end; ++edge_itt) {
-						domination[*edge_itt]++;
+						domination.increment(*edge_itt);
 					}
 				}
 				//Check if undominated N_prison can be dominated by a single N_prison.
 				for (auto i = prison_vertices.begin(); i < prison_vertices.end(); ++i) {
-					if (domination[*i] == size) {
+					if (domination.count(*i) == size) {
 						return false;
 					}
 				}
 				//Check if undominated N_prison can be dominated by a single N_guard.
 				for (auto i = guard_vertices.begin(); i < guard_vertices.end(); ++i) {
-					if (domination[*i] == size) {
+					if (domination.count(*i) == size) {
 						return false;
 					}
 				}
 				//Check if only v, dominates all undominated N_prison vertices.
-				bool dominated_by_v = (domination[v] == size);
+				bool dominated_by_v = (domination.count(v) == size);
 				//Check if only w, dominates all undominated N_prison vertices.
-				bool dominated_by_w = (domination[w] == size);
+				bool dominated_by_w = (domination.count(w) == size);
 				//divide the cases.
 				if (dominated_by_v && dominated_by_w) {
 					Logger::cnt_alber_rule_2_either++;
@@ -741,7 +847,7 @@ namespace reduce {
 					auto [neigh_itt_v, neigh_itt_v_end] = mds_context.get_neighborhood_itt(v);
 					for (; neigh_itt_v < neigh_itt_v_end; ++neigh_itt_v) {
 						//dominate neighborhood of w, because it gets included.
-						if (std::find(guard_vertices.begin(), guard_vertices.end(), *neigh_itt_v) != guard_vertices.end()) {
+						if (is_guard.contains(*neigh_itt_v)) {
 							//if it is a guard it can be removed.
 							mds_context.remove_vertex(*neigh_itt_v);
 						}
@@ -762,7 +868,7 @@ namespace reduce {
 					for (; neigh_itt_w < neigh_itt_w_end; ++neigh_itt_w) {
 						//dominate neighborhood of w, because it gets included.
 						mds_context.dominate_vertex(*neigh_itt_w);
-						if (std::find(guard_vertices.begin(), guard_vertices.end(), *neigh_itt_w) != guard_vertices.end()) {
+						if (is_guard.contains(*neigh_itt_w)) {
 							//if it is a guard it can be removed.
 							mds_context.remove_vertex(*neigh_itt_w);
 						}
@@ -799,19 +905,25 @@ namespace reduce {
 				return false;
 			}
 			// get adjacency lookup table & itteratable list of all neighbors of v & w (lookup includes v&w while itt. excludes them).
-			auto [lookup, pair_neighborhood_vector] = mds_context.get_pair_neighborhood(v, w);
+			neighborhood_scratch& scratch = get_scratch();
+			EPOCH_MARKER& lookup = scratch.lookup;
+			std::vector<vertex> pair_neighborhood_vector = mds_context.get_pair_neighborhood(v, w, lookup);
 
 			// partition neighborhood u into 3 sets.
 			std::vector<int>exit_vertices; //N_{3}
 			std::vector<int>guard_vertices; //N_{2}
 			std::vector<int>prison_vertices; //N_{1}
+			EPOCH_MARKER& is_exit = scratch.exit;
+			EPOCH_MARKER& is_guard = scratch.guard;
+			is_exit.clear(mds_context.get_total_vertices());
+			is_guard.clear(mds_context.get_total_vertices());
 
 			for (auto u = pair_neighborhood_vector.begin(); u < pair_neighborhood_vector.end(); ++u) {
 				//for each vertex get the neighborhood
 				auto [neigh_itt_u, neigh_itt_u_end] = mds_context.get_neighborhood_itt(*u);
 				//if ANY neighbor isn't in lookup (it belongs to exit_vertices).
 				for (;neigh_itt_u < neigh_itt_u_end; ++neigh_itt_u) {
-					if (lookup[*neigh_itt_u] == 0) {
+					if (!lookup.contains(*neigh_itt_u)) {
 						if (mds_context.is_dominated(*u) && mds_context.is_dominated(*neigh_itt_u)) {
 							continue;
 						}
@@ -822,6 +934,7 @@ namespace reduce {
 							continue;
 						}
 						exit_vertices.push_back(*u);
+						is_exit.insert(*u);
 						break;
 					}
 				}
@@ -829,7 +942,7 @@ namespace reduce {
 			//divide all non N_exit vertices into N_guard and N_prison. (could be abstracted).
 			for (auto u = pair_neighborhood_vector.begin(); u < pair_neighborhood_vector.end(); ++u) {
 				//check if vertex is not a exit_vertex.
-				if (std::find(exit_vertices.begin(), exit_vertices.end(), *u) != exit_vertices.end()) {
+				if (is_exit.contains(*u)) {
 					continue;
 				}
 				else {
@@ -838,8 +951,9 @@ namespace reduce {
 					auto [neigh_itt_u, neigh_itt_u_end] = mds_context.get_neighborhood_itt(*u);
 					for (;neigh_itt_u < neigh_itt_u_end; ++neigh_itt_u) {
 						//Check if it is a guard_vertex.
-						if (std::find(exit_vertices.begin(), exit_vertices.end(), *neigh_itt_u) != exit_vertices.end()) {
+						if (is_exit.contains(*neigh_itt_u)) {
 							guard_vertices.push_back(*u);
+							is_guard.insert(*u);
 							guard_trigger = true;
 							break;
 						}
@@ -864,30 +978,31 @@ namespace reduce {
 				int size = undominated_prison_vertices.size();
 				//create domination table. (how many vertices of undominated_prison_vertices can a vertex dominate).
 				int num_vertices = mds_context.get_total_vertices();
-				std::vector<int>domination = std::vector<int>(num_vertices, 0);
+				EPOCH_MARKER& domination = scratch.domination;
+				domination.clear(num_vertices);
 				for (auto i = undominated_prison_vertices.begin(); i < undominated_prison_vertices.end(); ++i) {
-					domination[*i]++; //dominate himself.
+					domination.increment(*i); //dominate himself.
 					auto [edge_itt, edge_itt_end] = mds_context.get_neighborhood_itt(*i);
 					for (;edge_itt, edge_itt < edge_itt_end; ++edge_itt) {
-						domination[*edge_itt]++;
+						domination.increment(*edge_itt);
 					}
 				}
 				//Check if undominated N_prison can be dominated by a single N_prison.
 				for (auto i = prison_vertices.begin(); i < prison_vertices.end(); ++i) {
-					if (domination[*i] == size) {
+					if (domination.count(*i) == size) {
 						return false;
 					}
 				}
 				//Check if undominated N_prison can be dominated by a single N_guard.
 				for (auto i = guard_vertices.begin(); i < guard_vertices.end(); ++i) {
-					if (domination[*i] == size) {
+					if (domination.count(*i) == size) {
 						return false;
 					}
 				}
 				//Check if only v, dominates all undominated N_prison vertices.
-				bool dominated_by_v = (domination[v] == size);
+				bool dominated_by_v = (domination.count(v) == size);
 				//Check if only w, dominates all undominated N_prison vertices.
-				bool dominated_by_w = (domination[w] == size);
+				bool dominated_by_w = (domination.count(w) == size);
 				//divide the cases.
 				if (dominated_by_v && dominated_by_w) {
 					++Logger::cnt_alber_rule_2_either;
@@ -929,7 +1044,7 @@ namespace reduce {
 					auto [neigh_itt_v, neigh_itt_v_end] = mds_context.get_neighborhood_itt(v);
 					for (; neigh_itt_v < neigh_itt_v_end; ++neigh_itt_v) {
 						//neighborhood of v gets dominated by select_vertex(v).
-						if (std::find(guard_vertices.begin(), guard_vertices.end(), *neigh_itt_v) != guard_vertices.end()) {
+						if (is_guard.contains(*neigh_itt_v)) {
 							//if it is a guard it can be removed.
 							mds_context.exclude_vertex(*neigh_itt_v);
 						}
@@ -948,7 +1063,7 @@ namespace reduce {
 					auto [neigh_itt_w, neigh_itt_w_end] = mds_context.get_neighborhood_itt(w);
 					for (; neigh_itt_w < neigh_itt_w_end; ++neigh_itt_w) {
 						//neighborhood of w gets dominated by select_vertex(w).
-						if (std::find(guard_vertices.begin(), guard_vertices.end(), *neigh_itt_w) != guard_vertices.end()) {
+						if (is_guard.contains(*neigh_itt_w)) {
 							//exclude guard vertices.
 							mds_context.exclude_vertex(*neigh_itt_w);
 						}
@@ -982,7 +1097,8 @@ namespace reduce {
 		bool reduced = false;
 		for (;neigh_v_itt < neigh_v_itt_end; ++neigh_v_itt) {
 			if (mds_context.is_dominated(*neigh_v_itt)) {
-				mds_context.remove_edge(v, *neigh_v_itt);
+				//removes the edge in O(1), the iterator stays valid and moves on to the next live neighbor.
+				mds_context.remove_edge(v, neigh_v_itt);
 				reduced = true;
 			}
 		}
@@ -999,8 +1115,7 @@ namespace reduce {
 		{
 			auto [it_neigh, it_neigh_end] = mds_context.get_neighborhood_itt(v);
 			if (mds_context.is_undetermined(*it_neigh)){
-				mds_context.removed[v] = true;
-				mds_context.excluded[v] = true;
+				mds_context.set_state(v, STATE_REMOVED | STATE_EXCLUDED);
 				return true;
 			}
 			return false;
@@ -1027,9 +1142,8 @@ namespace reduce {
 			}
 			//rule 3.1
 			if (mds_context.edge_exists(u_one, u_two)) {
-				mds_context.removed[v] = true;
-				mds_context.excluded[v] = true;
-				boost::clear_vertex(v, mds_context.graph);
+				mds_context.set_state(v, STATE_REMOVED | STATE_EXCLUDED);
+				mds_context.clear_vertex(v);
 				++Logger::cnt_alber_simple_rule_3dot1;
 				return true;
 			}
@@ -1038,9 +1152,8 @@ namespace reduce {
 			for (;neigh_u_one_itt < neigh_u_one_itt_end; ++neigh_u_one_itt) {
 				//u_2 must be not dominated & not excluded (or undetermined) (is allowed to be ignored /dominated)
 				if (*neigh_u_one_itt != v && mds_context.edge_exists(*neigh_u_one_itt, u_two) && mds_context.is_undetermined(*neigh_u_one_itt)) { //pretty sure this is a bug.
-					mds_context.removed[v] = true;
-					mds_context.excluded[v] = true;
-					boost::clear_vertex(v, mds_context.graph);
+					mds_context.set_state(v, STATE_REMOVED | STATE_EXCLUDED);
+					mds_context.clear_vertex(v);
 					++Logger::cnt_alber_simple_rule_3dot2;
 					return true;
 				}
@@ -1068,9 +1181,8 @@ namespace reduce {
 			bool exists = mds_context.edge_exists(u_one, u_two);
 			auto exists_2 = mds_context.edge_exists(u_two, u_three);
 			if (exists && exists_2 && mds_context.is_undetermined(u_one) && mds_context.is_undetermined(u_two) && mds_context.is_undetermined(u_three)) {
-				mds_context.removed[v] = true;
-				mds_context.excluded[v] = true;
-				boost::clear_vertex(v, mds_context.graph);
+				mds_context.set_state(v, STATE_REMOVED | STATE_EXCLUDED);
+				mds_context.clear_vertex(v);
 				return true;
 			}
 			return false;
@@ -1083,13 +1195,49 @@ namespace reduce {
 		if (v == u) {
 			return true;
 		}
-		auto [neigh_itt_v, neigh_itt_v_end] = mds_context.get_neighborhood_itt(v);
-		if (!std::binary_search(neigh_itt_v, neigh_itt_v_end, u)) {
+		//the neighborhoods are not sorted (gadget edges are appended), ask the edge index.
+		return mds_context.edge_exists(v, u);
+	}
+
+	bool contains_all(MDS_CONTEXT& mds_context, containment_query& query, vertex u) {
+		if (mds_context.graph.is_dense()) {
+			return mds_context.graph.closed_neighborhood_contains(u, query.vertex_set);
+		}
+		//the fingerprint of N[u] is a superset of the bits of its neighbors, a missing bit means a missing vertex.
+		if ((query.fingerprint & ~mds_context.graph.closed_neighborhood_fingerprint(u)) != 0) {
+			return false;
+		}
+		if (mds_context.graph.degree(u) + 1 < query.num_distinct) {
 			return false;
 		}
+		for (vertex v : *query.vertices) {
+			if (!contains(mds_context, v, u)) {
+				return false;
+			}
+		}
 		return true;
 	}
 
+	containment_query get_containment_query(MDS_CONTEXT& mds_context, std::vector<vertex>& vertices) {
+		containment_query query{ &vertices, 0, 0, boost::dynamic_bitset<>() };
+		EPOCH_MARKER& distinct = get_scratch().lookup;
+		distinct.clear(mds_context.get_total_vertices());
+		for (vertex v : vertices) {
+			if (!distinct.contains(v)) {
+				distinct.insert(v);
+				query.num_distinct++;
+			}
+			query.fingerprint |= DYNAMIC_GRAPH::fingerprint_bit(v);
+		}
+		if (mds_context.graph.is_dense()) {
+			query.vertex_set.resize(mds_context.get_total_vertices());
+			for (vertex v : vertices) {
+				query.vertex_set[v] = true;
+			}
+		}
+		return query;
+	}
+
 	bool check_subset(MDS_CONTEXT& mds_context, vertex v) {
 		//selecting this vertex doesn't provide new dominated vertices. (so it can be excluded)
 		if (mds_context.get_coverage_size(v) == 0) {
@@ -1124,6 +1272,8 @@ namespace reduce {
 			}
 		}
 
+		containment_query needs_to_dominate_query = get_containment_query(mds_context, needs_to_dominate);
+
 		//get all possible vertices which could be the superset.
 		auto [neigh_itt_mf, neigh_itt_mf_end] = mds_context.get_neighborhood_itt(minimum_frequency_vertex);
 		for (auto itt = neigh_itt_mf; itt < neigh_itt_mf_end; ++itt) {
@@ -1131,14 +1281,7 @@ namespace reduce {
 				continue;
 			}
 			// Check whether all vertices which needs to be dominated are adjacent to itt.
-			bool fail = false;
-			for (vertex dominated : needs_to_dominate) {
-				if (!contains(mds_context, dominated, *itt)) {
-					fail = true;
-					break;
-				}
-			}
-			if (!fail) {
+			if (contains_all(mds_context, needs_to_dominate_query, *itt)) {
 				return true;
 			}
 		}
@@ -1146,19 +1289,7 @@ namespace reduce {
 		if (minimum_frequency_vertex == v || !mds_context.is_undetermined(minimum_frequency_vertex)) {
 			return false;
 		}
-		bool fail = false;
-		for (vertex dominated : needs_to_dominate) {
-			if (!contains(mds_context, dominated, minimum_frequency_vertex)) {
-				fail = true;
-				break;
-			}
-		}
-		if (!fail) {
-			return true;
-		}
-		else {
-			return false;
-		}
+		return contains_all(mds_context, needs_to_dominate_query, minimum_frequency_vertex);
 	}
 
 	bool reduce_subset(MDS_CONTEXT& mds_context, vertex v) {
@@ -1201,19 +1332,14 @@ namespace reduce {
 			need_to_cover.push_back(v);
 		}
 
+		containment_query need_to_cover_query = get_containment_query(mds_context, need_to_cover);
+
 		auto [neigh_itt_mc, neigh_itt_mc_end] = mds_context.get_neighborhood_itt(minimum_coverage_vertex);
 		for (auto itt = neigh_itt_mc; itt < neigh_itt_mc_end; ++itt) {
 			if (*itt == v || mds_context.is_dominated_ijcai(*itt) || mds_context.get_frequency(*itt) < mds_context.get_frequency(v)) {
 				continue;
 			}
-			bool fail = false;
-			for (vertex cover : need_to_cover) {
-				if (!contains(mds_context, cover, *itt)) {
-					fail = true;
-					break;
-				}
-			}
-			if (!fail) {
+			if (contains_all(mds_context, need_to_cover_query, *itt)) {
 				mds_context.ignore_vertex(*itt);
 				reduced = true;
 			}
@@ -1222,14 +1348,7 @@ namespace reduce {
 			return reduced;
 		}
 		else {
-			bool fail = false;
-			for (vertex cover : need_to_cover) {
-				if (!contains(mds_context, cover, minimum_coverage_vertex)) {
-					fail = true;
-					break;
-				}
-			}
-			if (!fail) {
+			if (contains_all(mds_context, need_to_cover_query, minimum_coverage_vertex)) {
 				mds_context.ignore_vertex(minimum_coverage_vertex);
 				reduced = true;
 			}
@@ -1269,7 +1388,8 @@ namespace reduce {
 
 		//get neighbourhood l.
 		timer t_divide_neighborhood;
-		std::unordered_set<int> lookup_neighbourhood;
+		neighborhood_scratch& scratch = get_scratch();
+		EPOCH_MARKER& lookup_neighbourhood = scratch.lookup;
 		std::vector<int> l_neighbourhood;
 		mds_context.get_l_neighborhood(l_vertices, lookup_neighbourhood, l_neighbourhood);
 
@@ -1277,6 +1397,8 @@ namespace reduce {
 		std::vector<int>exit_vertices; //N_{3}
 		std::vector<int>guard_vertices; //N_{2}
 		std::vector<int>prison_vertices; //N_{1}
+		EPOCH_MARKER& is_exit = scratch.exit;
+		is_exit.clear(mds_context.get_total_vertices());
 
 		// get N_exit(V_l)
 
@@ -1285,7 +1407,7 @@ namespace reduce {
 			auto [neigh_itt_u, neigh_itt_u_end] = mds_context.get_neighborhood_itt(*u);
 			//if ANY neighbor isn't in lookup (it belongs to exit_vertices).
 			for (;neigh_itt_u != neigh_itt_u_end; ++neigh_itt_u) {
-				if (lookup_neighbourhood.find(*neigh_itt_u) == lookup_neighbourhood.end()) {
+				if (!lookup_neighbourhood.contains(*neigh_itt_u)) {
 					if (mds_context.is_dominated(*u) && mds_context.is_dominated(*neigh_itt_u)) {
 						continue;
 					}
@@ -1296,6 +1418,7 @@ namespace reduce {
 						continue;
 					}
 					exit_vertices.push_back(*u);
+					is_exit.insert(*u);
 					break;
 				}
 			}
@@ -1303,13 +1426,13 @@ namespace reduce {
 		//divide all non N_exit vertices into N_guard and N_prison. (could be abstracted).
 		for (auto u = l_neighbourhood.begin(); u != l_neighbourhood.end(); ++u) {
 			//check if vertex is not a exit_vertex.
-			if (std::find(exit_vertices.begin(), exit_vertices.end(), *u) == exit_vertices.end()){
+			if (!is_exit.contains(*u)){
 				bool guard_trigger = false;
 				//check if a neighbor vertex is adjacent to a exit_vertex.
 				auto [neigh_itt_u, neigh_itt_u_end] = mds_context.get_neighborhood_itt(*u);
 				for (;neigh_itt_u < neigh_itt_u_end; ++neigh_itt_u) {
 					//Check if it is a guard_vertex.
-					if (std::find(exit_vertices.begin(), exit_vertices.end(), *neigh_itt_u) != exit_vertices.end()) {
+					if (is_exit.contains(*neigh_itt_u)) {
 						guard_vertices.push_back(*u);
 						guard_trigger = true;
 						break;
@@ -1333,52 +1456,59 @@ namespace reduce {
 		//Is there a chance on profit.
 		if (!undominated_prison_vertices.empty()) {
 			timer t_domination;
+			//a combination dominates if its coverage (bit j: undominated_prison_vertices[j] is in N[combination]) is full.
+			const std::size_t num_undominated = undominated_prison_vertices.size();
+			//a vertex which is repeated in l_vertices shares the local id of its first occurrence.
+			LOCAL_INDEX& candidate_id = scratch.candidate_id;
+			candidate_id.clear(mds_context.get_total_vertices());
+			std::vector<int> l_id(l_vertices.size());
+			for (std::size_t i = 0; i < l_vertices.size(); ++i) {
+				l_id[i] = candidate_id.insert(l_vertices[i]);
+			}
+			std::vector<boost::dynamic_bitset<>> l_coverage(candidate_id.size(), boost::dynamic_bitset<>(num_undominated));
+			get_coverage(mds_context, undominated_prison_vertices, candidate_id, l_coverage);
+
 			std::vector<std::vector<int>>dominating_subsets;
+			std::vector<std::uint32_t>dominating_masks; //local ids of the dominating subsets.
+			boost::dynamic_bitset<> dominated(num_undominated);
 			//find all combinations.
 			const int total_combinations = 1 << l_vertices.size();
 
 			for (int mask = 1; mask < total_combinations; mask++) {
-				std::vector<int> combination;
-				for (int i = 0; i < l_vertices.size(); ++i){
+				std::uint32_t id_mask = 0;
+				for (std::size_t i = 0; i < l_vertices.size(); ++i){
 					if (mask & (1 << i)) {
-						combination.push_back(l_vertices[i]);
+						id_mask |= std::uint32_t(1) << l_id[i];
 					}
 				}
-				//check the combination.
-				bool skip_combination = false;  // Flag to track whether to skip the combination
-
-				for (auto& subset : dominating_subsets) {
-					//if subset is a (subset) of combination then go further.
-					bool is_subset = true;
-					for (auto& elem : subset) {
-						if (std::find(combination.begin(), combination.end(), elem) == combination.end()) {
-							is_subset = false;
-							break; // No need to continue checking if one element is missing
-						}
-					}
-
-					if (is_subset) {
+				//skip the combination if a dominating subset is a subset of it.
+				bool skip_combination = false;
+				for (std::uint32_t subset_mask : dominating_masks) {
+					if ((subset_mask & ~id_mask) == 0) {
 						skip_combination = true;
 						break;
 					}
 				}
-
 				if (skip_combination){
 					continue;
 				}
 
 				//check if the combination dominates.
-				std::unordered_set<int> dominated_vertices;
-				mds_context.get_lookup_l_neighborhood(combination, dominated_vertices);
-				bool dominates = true;
-				for (int undominated_prison_vertex : undominated_prison_vertices){
-					if (dominated_vertices.find(undominated_prison_vertex) == dominated_vertices.end()) {
-						dominates = false;
-						break;
+				dominated.reset();
+				for (int id = 0; id < candidate_id.size(); ++id) {
+					if (id_mask & (std::uint32_t(1) << id)) {
+						dominated |= l_coverage[id];
 					}
 				}
-				if (dominates) {
+				if (dominated.count() == num_undominated) {
+					std::vector<int> combination;
+					for (std::size_t i = 0; i < l_vertices.size(); ++i){
+						if (mask & (1 << i)) {
+							combination.push_back(l_vertices[i]);
+						}
+					}
 					dominating_subsets.emplace_back(combination);
+					dominating_masks.push_back(id_mask);
 				}
 			}
 			Logger::execution_dominations += t_domination.count();
@@ -1395,30 +1525,41 @@ namespace reduce {
 				}
 			}
 
-			std::vector<std::pair<std::unordered_set<int>,int>> collection_lookup_dominating_subsets;
 			timer t_is_stronger;
-			for (auto& w : dominating_subsets) {
-				std::unordered_set<int> neighborhood_w;
-				mds_context.get_lookup_l_neighborhood(w, neighborhood_w);
-				collection_lookup_dominating_subsets.emplace_back(neighborhood_w,w.size());
+			//N[l_vertices] gets local ids, N[W] of a dominating subset W is a bitmask over them.
+			LOCAL_INDEX& closed_id = scratch.closed_neighborhood_id;
+			closed_id.clear(mds_context.get_total_vertices());
+			for (int v : l_vertices) {
+				closed_id.insert(v);
+				auto [neigh_itt, neigh_itt_end] = mds_context.get_neighborhood_itt(v);
+				for (; neigh_itt < neigh_itt_end; ++neigh_itt) {
+					closed_id.insert(*neigh_itt);
+				}
+			}
+			std::vector<boost::dynamic_bitset<>> l_neighborhoods(candidate_id.size(), boost::dynamic_bitset<>(closed_id.size()));
+			for (std::size_t i = 0; i < l_vertices.size(); ++i) {
+				get_closed_neighborhood(mds_context, l_vertices[i], closed_id, l_neighborhoods[l_id[i]]);
+			}
+			std::vector<boost::dynamic_bitset<>> dominating_neighborhoods;
+			for (std::uint32_t subset_mask : dominating_masks) {
+				boost::dynamic_bitset<> neighborhood_w(closed_id.size());
+				for (int id = 0; id < candidate_id.size(); ++id) {
+					if (subset_mask & (std::uint32_t(1) << id)) {
+						neighborhood_w |= l_neighborhoods[id];
+					}
+				}
+				dominating_neighborhoods.push_back(std::move(neighborhood_w));
 			}
 
 			// All are stronger.
-			std::unordered_set<int>intersection_neighborhood;
-			auto [dom, size] = collection_lookup_dominating_subsets.back();
-			for (auto elem : dom)
-			{
-				bool all_present = true;
-				for (auto& [domination, s] : collection_lookup_dominating_subsets){
-					if (domination.find(elem) == domination.end()) {
-						all_present = false;
-						break;
-					};
-				}
-				if (all_present) {
-					intersection_neighborhood.insert(elem);
-				}
+			boost::dynamic_bitset<> intersection_neighborhood = dominating_neighborhoods.back();
+			for (auto& neighborhood_w : dominating_neighborhoods) {
+				intersection_neighborhood &= neighborhood_w;
 			}
+			auto in_intersection = [&](int v) {
+				const int id = closed_id.id(v);
+				return id >= 0 && intersection_neighborhood[id];
+			};
 
 			// if (dominating_subsets.size() != 1) {
 			// 			return false;
@@ -1432,14 +1573,15 @@ namespace reduce {
 
 			for (auto prison : prison_vertices)
 			{
-				if (intersection_neighborhood.find(prison) == intersection_neighborhood.end()) {
+				if (!in_intersection(prison)) {
 					continue;
 				}
 				auto [prison_it, prison_it_end] = mds_context.get_neighborhood_itt(prison);
 				bool is_subset = true;
 				for (auto it = prison_it; it != prison_it_end; ++it) {
-					if (intersection_neighborhood.find(*it) == intersection_neighborhood.end()) {
+					if (!in_intersection(*it)) {
 						is_subset = false;
+						break;
 					}
 				}
 				if (!is_subset) {
@@ -1454,14 +1596,15 @@ namespace reduce {
 			}
 			for (auto guard : guard_vertices)
 			{
-				if (intersection_neighborhood.find(guard) == intersection_neighborhood.end()) {
+				if (!in_intersection(guard)) {
 					continue;
 				}
 				auto [guard_it, guard_it_end] = mds_context.get_neighborhood_itt(guard);
 				bool is_subset = true;
 				for (auto it = guard_it; it != guard_it_end; ++it) {
-					if (intersection_neighborhood.find(*it) == intersection_neighborhood.end()) {
+					if (!in_intersection(*it)) {
 						is_subset = false;
+						break;
 					}
 				}
 				if (!is_subset)
@@ -1495,120 +1638,113 @@ namespace reduce {
 			// }
 
 			timer t_alternative;
-			std::unordered_set<int> lookup_n_prison_neighbourhood;
+			EPOCH_MARKER& lookup_n_prison_neighbourhood = scratch.lookup;
 			std::vector<int> n_prison_neighbourhood;
 			mds_context.get_l_neighborhood(prison_vertices, lookup_n_prison_neighbourhood, n_prison_neighbourhood);
 			for (int prison_vertex : prison_vertices) {
 				n_prison_neighbourhood.push_back(prison_vertex);
 			}
 
-			//Find all alternative dominations which are smaller than
-			// For each size from 1 to max_size
-			std::vector<std::vector<int>>alternative_dominations;
-			for (int size = 1; size < l_vertices.size(); ++size) {
-				// Generate all permutations of the given size
-				std::vector<int> combination(size);
-				std::vector<bool> chosen(n_prison_neighbourhood.size(), false);
-
-				// Lambda function to generate combinations
-				std::function<void(int)> generate = [&](int index) {
-					if (index == size) {
-						// for (int vertex : combination){
-						// 	if (mds_context.is_excluded(vertex)){
-						// 		return;
-						// 	}
-						// }
-
-						// Do something with domination.
-						//check the combination.
-						bool skip_combination = false;  // Flag to track whether to skip the combination
-
-						for (auto& subset : alternative_dominations) {
-							//if subset is a (subset) of combination then go further.
-							bool is_subset = true;
-							for (auto& elem : subset) {
-								if (std::find(combination.begin(), combination.end(), elem) == combination.end()) {
-									is_subset = false;
-									break; // No need to continue checking if one element is missing
-								}
-							}
-
-							if (is_subset) {
-								skip_combination = true;
-								break;
-							}
-						}
-
-						if (skip_combination){
-							return;
-						}
+			//the alternative dominations which have to be checked are the minimal ones (no dominating proper subset) with
+			//less than l vertices, every other dominating combination contains one of them.
+			//a vertex which dominates no undominated prison vertex is in no minimal domination.
+			candidate_id.clear(mds_context.get_total_vertices());
+			std::vector<int> candidate_vertex; // local id -> vertex.
+			for (int u : n_prison_neighbourhood) {
+				if (candidate_id.insert(u) == static_cast<int>(candidate_vertex.size())) {
+					candidate_vertex.push_back(u);
+				}
+			}
+			std::vector<boost::dynamic_bitset<>> coverage(candidate_id.size(), boost::dynamic_bitset<>(num_undominated));
+			get_coverage(mds_context, undominated_prison_vertices, candidate_id, coverage);
+			std::vector<int> alternative_candidates;
+			for (int id = 0; id < candidate_id.size(); ++id) {
+				if (coverage[id].any()) {
+					alternative_candidates.push_back(id);
+				}
+			}
+			//N[u] of a candidate over the local ids of N[l_vertices], outside if a vertex of N[u] has no local id (no N[W] contains it).
+			std::vector<boost::dynamic_bitset<>> candidate_neighborhoods(candidate_id.size());
+			std::vector<bool> outside(candidate_id.size(), false);
+			for (int id : alternative_candidates) {
+				candidate_neighborhoods[id].resize(closed_id.size());
+				outside[id] = !get_closed_neighborhood(mds_context, candidate_vertex[id], closed_id, candidate_neighborhoods[id]);
+			}
 
-						//check if the combination dominates.
-						std::unordered_set<int> dominated_vertices;
-						mds_context.get_lookup_l_neighborhood(combination, dominated_vertices);
-						bool dominates = true;
-						for (int undominated_prison_vertex : undominated_prison_vertices){
-							if (dominated_vertices.find(undominated_prison_vertex) == dominated_vertices.end()) {
-								dominates = false;
-								break;
-							}
-						}
-						if (dominates) {
-							alternative_dominations.emplace_back(combination);
+			//if for all W in W_alternative, which is better.
+			auto is_minimal = [&](std::vector<int>& w_alter) {
+				boost::dynamic_bitset<> others(num_undominated);
+				for (int skip : w_alter) {
+					others.reset();
+					for (int id : w_alter) {
+						if (id != skip) {
+							others |= coverage[id];
 						}
-						return;
 					}
-
-					// Try each element in the set to be included in the current combination
-					for (int i = 0; i < n_prison_neighbourhood.size(); ++i) {
-						if (!chosen[i]) {
-							combination[index] = n_prison_neighbourhood[i];
-							chosen[i] = true;
-							generate(index + 1);  // Recurse to the next position
-							chosen[i] = false;    // Unmark the current element (backtrack)
-						}
+					if (others.count() == num_undominated) {
+						return false;
 					}
-				};
-
-				// Start the recursive generation from index 0
-				generate(0);
-			}
-			Logger::execution_alternative_dominations += t_alternative.count();
-			//if for all W in W_alternative, which is better.
+				}
+				return true;
+			};
+			auto is_covered = [&](std::vector<int>& w_alter) {
+				boost::dynamic_bitset<> neighborhood_alter(closed_id.size());
+				for (int id : w_alter) {
+					if (outside[id]) {
+						return false;
+					}
+					neighborhood_alter |= candidate_neighborhoods[id];
+				}
+				for (std::size_t w = 0; w < dominating_subsets.size(); ++w) {
+					if (dominating_subsets[w].size() <= w_alter.size() && neighborhood_alter.is_subset_of(dominating_neighborhoods[w])) {
+						return true;
+					}
+				}
+				return false;
+			};
 
 			bool is_stronger = true;
-			bool subset = false;
-			for (auto& w_alter : alternative_dominations) {
-				for (auto& [subset_w,w_size] : collection_lookup_dominating_subsets ) {
-					subset = false;
-					if (w_size <= w_alter.size())
-					{
-						if (is_superset(mds_context, subset_w, w_alter)){
-							subset = true;
-							break;
+			const std::size_t max_size = l_vertices.empty() ? 0 : l_vertices.size() - 1;
+			std::vector<int> w_alter;
+			//covered[d]: coverage of the first d vertices of w_alter.
+			std::vector<boost::dynamic_bitset<>> covered(l_vertices.size(), boost::dynamic_bitset<>(num_undominated));
+			std::function<void(std::size_t)> generate = [&](std::size_t start) {
+				const std::size_t depth = w_alter.size();
+				for (std::size_t i = start; i < alternative_candidates.size() && is_stronger; ++i) {
+					const int id = alternative_candidates[i];
+					//a vertex which adds nothing to the smaller ones makes the combination not minimal.
+					if (coverage[id].is_subset_of(covered[depth])) {
+						continue;
+					}
+					covered[depth + 1] = covered[depth];
+					covered[depth + 1] |= coverage[id];
+					w_alter.push_back(id);
+					if (covered[depth + 1].count() == num_undominated) {
+						//a dominating combination is not extended, its supersets are not minimal.
+						if (is_minimal(w_alter) && !is_covered(w_alter)) {
+							is_stronger = false;
 						}
+					} else if (depth + 1 < max_size) {
+						generate(i + 1);
 					}
+					w_alter.pop_back();
 				}
-				if (!subset){
-					is_stronger = false;
-					break;
-				}
+			};
+			if (max_size >= 1) {
+				generate(0);
 			}
+			Logger::execution_alternative_dominations += t_alternative.count();
 			 if (!is_stronger){
 			 	return false;
 			 }
 
 			for (auto prison : removable_prison_vertices){
-				mds_context.dominated[prison] = true;
-				mds_context.excluded[prison] = true;
-				mds_context.removed[prison] = true;
-				boost::clear_vertex(prison, mds_context.graph);
+				mds_context.set_state(prison, STATE_DOMINATED | STATE_EXCLUDED | STATE_REMOVED);
+				mds_context.clear_vertex(prison);
 			}
 			for (auto guard : removable_guard_vertices){
-				mds_context.dominated[guard] = true;
-				mds_context.excluded[guard] = true;
-				mds_context.removed[guard] = true;
-				boost::clear_vertex(guard, mds_context.graph);
+				mds_context.set_state(guard, STATE_DOMINATED | STATE_EXCLUDED | STATE_REMOVED);
+				mds_context.clear_vertex(guard);
 			}
 
 			if (dominating_subsets.size() == 1){
@@ -1616,15 +1752,13 @@ namespace reduce {
 				//std::cout << "new selected vertex found. l_rule" << std::endl;
 				//This one can be included.
 				for (auto& i : dominating_subsets[0]){
-					mds_context.selected[i] = true;
-					mds_context.excluded[i] = true;
-					mds_context.dominated[i] = true;
+					mds_context.set_state(i, STATE_SELECTED | STATE_EXCLUDED | STATE_DOMINATED);
 					auto [itt, itt_end] = mds_context.get_neighborhood_itt(i);
 					for (; itt != itt_end; itt++) {
-						mds_context.dominated[*itt] = true;
+						mds_context.set_state(*itt, STATE_DOMINATED);
 					}
-					mds_context.removed[i] = true;
-					boost::clear_vertex(i, mds_context.graph);
+					mds_context.set_state(i, STATE_REMOVED);
+					mds_context.clear_vertex(i);
 				}
 				return true;
 			} else
@@ -1679,7 +1813,7 @@ namespace reduce {
 					}
 				}
 				for (auto& selector : selector_vertices){
-						mds_context.excluded[selector] = true;
+						mds_context.set_state(selector, STATE_EXCLUDED);
 				}
 				Logger::execution_is_stronger += t_is_stronger.count();
 				return true;
@@ -1700,19 +1834,4 @@ namespace reduce {
 			generateSelectors(W_sizes, current, index + 1, selectorVertices);
 		}
 	}
-
-	bool is_superset(MDS_CONTEXT& mds_context, std::unordered_set<int>& subset_w, std::vector<int>& w_alter) {
-		for (vertex v : w_alter){
-			if (subset_w.find(v) == subset_w.end()){
-				return false;
-			}
-			auto [it, it_end] = mds_context.get_neighborhood_itt(v);
-			for (; it != it_end; ++it) {
-				if (subset_w.find(*it) == subset_w.end()){
-					return false;
-				}
-			}
-		}
-		return true;
-	}
 }
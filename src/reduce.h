@@ -1,11 +1,13 @@
 #pragma once
 #include "graph/context.h"
+#include "graph/worklist.h"
 
 #include "util/logger.h"
 
 #include <chrono>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/graph_traits.hpp>
+#include <boost/dynamic_bitset.hpp>
 
 namespace reduce {
     void reduction_rule_manager(MDS_CONTEXT& mds_context, strategy_reduction& strategy, int l, bool theory_strategy, std::chrono::time_point<std::chrono::steady_clock> start, std::chrono::seconds timeout_duration);
@@ -22,7 +24,8 @@ namespace reduce {
 
     void reduce_l_alber(MDS_CONTEXT& mds_context, int l, bool theory_strategy, std::chrono::time_point<std::chrono::steady_clock> start, std::chrono::seconds timeout_duration);
 
-    bool execute_l_alber(MDS_CONTEXT& mds_context, int l, int counter, std::vector<int> vertices);
+    //worklist holds the dirty vertices of the simple rules (see reduce_l_alber).
+    bool execute_l_alber(MDS_CONTEXT& mds_context, WORKLIST& worklist, int l, int counter, std::vector<int> vertices);
 
     std::vector<vertex> bfs_get_distance_three_generalized(MDS_CONTEXT& mds_context, std::vector<int>& vertices);
 
@@ -52,6 +55,20 @@ namespace reduce {
 
     bool contains(MDS_CONTEXT& mds_context, vertex v, vertex u);
 
+    //vertices which a superset candidate has to dominate, prepared once for all candidates of a rule.
+    struct containment_query {
+        std::vector<vertex>* vertices;
+        int num_distinct;                    // parallel edges can repeat a vertex.
+        std::uint64_t fingerprint;           // union of the fingerprint bits of the vertices (see DYNAMIC_GRAPH::fingerprint_bit).
+        boost::dynamic_bitset<> vertex_set;  // the vertices as bitset for the matrix rows, empty if the graph is not dense.
+    };
+
+    containment_query get_containment_query(MDS_CONTEXT& mds_context, std::vector<vertex>& vertices);
+
+    //true if all vertices of query are in N[u]. a candidate whose fingerprint misses a bit of the query or whose degree
+    //is too small is rejected without looking up an edge. in dense mode vertex_set is tested against the matrix row of u.
+    bool contains_all(MDS_CONTEXT& mds_context, containment_query& query, vertex u);
+
     bool check_subset(MDS_CONTEXT& mds_context, vertex v);
 
     bool reduce_subset(MDS_CONTEXT& mds_context, vertex v);
@@ -59,6 +76,4 @@ namespace reduce {
     bool reduce_ignore(MDS_CONTEXT& mds_context, vertex v);
 
     bool reduce_single_dominator(MDS_CONTEXT& mds_context, vertex v);
-
-    bool is_superset(MDS_CONTEXT& mds_context, std::unordered_set<int>& subset_w, std::vector<int>& w_alter);
 }
\ No newline at end of file
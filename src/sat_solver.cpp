@@ -6,6 +6,8 @@
 #include <stdlib.h>
 
 #include "util/timer.h"
+#include "domination_model.h"
+#include "graph/graph_io.h"
 #include <string>
 #include "ortools/sat/cp_model.h"
 #include "ortools/sat/cp_model.pb.h"
@@ -17,25 +19,17 @@
 using namespace operations_research::sat;
 
 
-std::vector<int> sat_solver_dominating_set(MDS_CONTEXT& mds_context, adjacencyListBoost& graph, std::unordered_map<int,int>& newToOldIndex){
+//CP-SAT formulation of the domination_model.
+template <typename F>
+static std::vector<int> build_and_solve(MDS_CONTEXT& mds_context, int num_vertices, F&& for_each_neighbor, const std::vector<int>& newToOldIndex){
     CpModelBuilder cp_model;
 
-    std::unordered_map<int, int> translation_pace_to_ilp;
-    std::unordered_map<int, int> translation_ilp_to_pace;
     //create decision variables.
-
+    domination_model::variables vars = domination_model::create_variables(mds_context, num_vertices, newToOldIndex);
     operations_research::Domain domain(0, 1);
     std::vector<IntVar> decision_vars;
-
-    int index = 0;
-    for (int i = 0; i < boost::num_vertices(graph); ++i)
-    {
-        if (mds_context.is_undetermined(newToOldIndex[i])){
-            decision_vars.push_back(cp_model.NewIntVar(domain).WithName(std::to_string(i)));
-            translation_pace_to_ilp[i] = index;
-            translation_ilp_to_pace[index] = i;
-            index++;
-        }
+    for (int i : vars.vertex_of) {
+        decision_vars.push_back(cp_model.NewIntVar(domain).WithName(std::to_string(i)));
     }
 
     if (decision_vars.empty()){
@@ -44,43 +38,13 @@ std::vector<int> sat_solver_dominating_set(MDS_CONTEXT& mds_context, adjacencyLi
     }
 
     //Create constraint.
-    for (int i = 0; i < boost::num_vertices(graph); i++) { //|| mds_context.is_ignored(newToOldIndex[i])
-        if (mds_context.is_dominated(newToOldIndex[i])){
-            continue;
-        }
-        auto [neigh_itt, neigh_itt_end] = boost::adjacent_vertices(i, graph);
-        std::vector<int> undetermined_neighbours;
-        int num_neighbours = 0;
-        undetermined_neighbours.reserve(std::distance(neigh_itt, neigh_itt_end));
-        for (auto vertex = neigh_itt ; vertex != neigh_itt_end; ++vertex) {
-            num_neighbours++;
-            if (mds_context.is_undetermined(newToOldIndex[*vertex])){
-                if (mds_context.is_removed(newToOldIndex[*vertex]))
-                {
-                    throw std::runtime_error("bad");
-                }
-                undetermined_neighbours.push_back(*vertex);
-            }
-        }
+    domination_model::for_each_constraint(mds_context, num_vertices, for_each_neighbor, newToOldIndex, vars, [&](int, const std::vector<int>& row) {
         LinearExpr sum;
-        int cnt = 0;
-        for (int j : undetermined_neighbours) {
-            sum += decision_vars[translation_pace_to_ilp[j]];
-            cnt++;
-        }
-        if (mds_context.is_undetermined(newToOldIndex[i])){
-            sum += decision_vars[translation_pace_to_ilp[i]];
-             cnt++;
-        }
-        if (cnt == 0){
-            std::cout << mds_context.is_excluded(newToOldIndex[i]);
-            std::cout << mds_context.is_removed(newToOldIndex[i]);
-            std::cout << mds_context.is_undetermined(newToOldIndex[i]);
-            std::cout << "is_bad" << std::endl;
-            std::cout << num_neighbours << std::endl;
+        for (int x : row) {
+            sum += decision_vars[x];
         }
         cp_model.AddGreaterOrEqual(sum , 1);
-    }
+    });
 
     LinearExpr sum;
     for (auto && decision_var : decision_vars) {
@@ -101,25 +65,43 @@ std::vector<int> sat_solver_dominating_set(MDS_CONTEXT& mds_context, adjacencyLi
         std::vector<int> solution;
         for (int c = 0; c < decision_vars.size(); c++) {
             if (1 == SolutionIntegerValue(response, decision_vars[c])) {
-                solution.push_back(translation_ilp_to_pace[c]);
+                solution.push_back(vars.vertex_of[c]);
             }
         }
         return solution;
     }
-        if (response.status() == CpSolverStatus::INFEASIBLE)
-        {
-            throw std::runtime_error("no optimal solution");
-        }
-        std::cout << response.status() << std::endl;
-        std::vector<int> solution;
-        std::ofstream outfile("/home/floris/github/minimum-dominating-set/score.txt", std::ios::app);
-        if (!outfile) {
-            std::cerr << "Error: Could not open file for writing.\n";
-            return solution;
+    if (response.status() == CpSolverStatus::INFEASIBLE)
+    {
+        throw std::runtime_error("no optimal solution");
+    }
+    //timed out: take the best solution found so far, without one all undetermined vertices (always dominating).
+    std::cout << response.status() << std::endl;
+    std::cout << "time_out" << std::endl;
+    Logger::timed_out = true;
+    const bool has_feasible = response.status() == CpSolverStatus::FEASIBLE;
+    std::vector<int> solution;
+    for (int c = 0; c < decision_vars.size(); c++) {
+        if (!has_feasible || 1 == SolutionIntegerValue(response, decision_vars[c])) {
+            solution.push_back(vars.vertex_of[c]);
         }
-        outfile << "timed_out" << "\n";
-        std::cout << "time_out" << std::endl;
-        Logger::timed_out = true;
+    }
+    std::ofstream outfile("/home/floris/github/minimum-dominating-set/score.txt", std::ios::app);
+    if (!outfile) {
+        std::cerr << "Error: Could not open file for writing.\n";
         return solution;
+    }
+    outfile << "timed_out" << "\n";
+    return solution;
+}
+
+std::vector<int> sat_solver_dominating_set(MDS_CONTEXT& mds_context, const CSR_GRAPH& graph, const std::vector<int>& newToOldIndex){
+    return build_and_solve(mds_context, graph.num_vertices, domination_model::neighbors_of(graph), newToOldIndex);
+}
+
+std::vector<int> sat_solver_dominating_set(MDS_CONTEXT& mds_context, adjacencyListBoost& boost_graph, const std::vector<int>& newToOldIndex){
+    return build_and_solve(mds_context, boost::num_vertices(boost_graph), domination_model::neighbors_of(boost_graph), newToOldIndex);
+}
 
+std::vector<int> sat_solver_dominating_set(MDS_CONTEXT& mds_context, const SUBGRAPH_VIEW& view){
+    return build_and_solve(mds_context, view.num_vertices(), domination_model::neighbors_of(view), view.local_to_global());
 }
@@ -12,4 +12,10 @@ typedef boost::adjacency_list<
 
 typedef boost::graph_traits<adjacencyListBoost>::vertex_descriptor vertex;
 
-std::vector<int> sat_solver_dominating_set(MDS_CONTEXT& mds_context, adjacencyListBoost& graph, std::unordered_map<int,int>& newToOldIndex);
\ No newline at end of file
+//the solution is in vertices of graph, newToOldIndex[i] is the vertex of mds_context for vertex i.
+std::vector<int> sat_solver_dominating_set(MDS_CONTEXT& mds_context, const CSR_GRAPH& graph, const std::vector<int>& newToOldIndex);
+
+std::vector<int> sat_solver_dominating_set(MDS_CONTEXT& mds_context, adjacencyListBoost& graph, const std::vector<int>& newToOldIndex);
+
+//view is a view of the graph of mds_context, the solution is in local vertices of the view.
+std::vector<int> sat_solver_dominating_set(MDS_CONTEXT& mds_context, const SUBGRAPH_VIEW& view);
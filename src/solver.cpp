@@ -2,8 +2,10 @@
 #include<cassert>
 #include "Highs.h"
 #include "graph/context.h"
+#include "graph/graph_io.h"
 #include <stdexcept>
 #include "util/logger.h"
+#include "domination_model.h"
 
 
 namespace operations_research {
@@ -18,29 +20,18 @@ namespace operations_research {
         return value;  // Otherwise, return the original value
     }
 
-    std::vector<int> ilp_solver(MDS_CONTEXT& mds_context, adjacencyListBoost& graph, std::unordered_map<int,int>& newToOldIndex) {
+    //HiGHS formulation of the domination_model.
+    template <typename F>
+    static std::vector<int> build_and_solve(MDS_CONTEXT& mds_context, int num_vertices, F&& for_each_neighbor, const std::vector<int>& newToOldIndex) {
         //initialize the needed information.
-        std::unordered_map<int,int> translation_pace_to_ilp;
-        std::unordered_map<int,int> translation_ilp_to_pace;
-
-        std::vector<int> undetermined_vertices;
-
-        int index = 0;
-        for (int i = 0; i < boost::num_vertices(graph); i++) {
-            if (mds_context.is_undetermined(newToOldIndex[i])) {
-                undetermined_vertices.push_back(i);
-                translation_pace_to_ilp[i] = index;
-                translation_ilp_to_pace[index] = i;
-                index++;
-            }
-        }
+        domination_model::variables vars = domination_model::create_variables(mds_context, num_vertices, newToOldIndex);
 
-        if (undetermined_vertices.empty()) {
+        if (vars.vertex_of.empty()) {
             return std::vector<int>();
         }
 
-        int num_vars = undetermined_vertices.size();
-        int total_vertices = boost::num_vertices(graph);
+        int num_vars = vars.vertex_of.size();
+        int total_vertices = num_vertices;
         int counter_ign_dom = 0;
         //number of vertices you can ignore.
         for (int i = 0; i < total_vertices; ++i) {
@@ -75,38 +66,14 @@ namespace operations_research {
         HighsSparseMatrix a;
         a.format_ = MatrixFormat::kRowwise;
         a.start_ = vector<HighsInt>(1, 0); // single element 0.
-        for (int i = 0; i < total_vertices; i++) {
-            HighsInt cnt = 0;
-            //vertex v = mds_context.get_vertex_from_index(i);
-            if (mds_context.is_dominated(newToOldIndex[i])) { //should be faster right?
-                continue; //dominated vertices  do not need a contraint.
-            }
-            auto [neigh_v_itt, neigh_v_itt_end] = boost::adjacent_vertices(i, graph);
-            //std::vector<int>index;
-            if (mds_context.is_undetermined(newToOldIndex[i])) {
-                //.push_back(translation_pace_to_ilp[i]);
-                a.index_.push_back(translation_pace_to_ilp[i]);
+        domination_model::for_each_constraint(mds_context, total_vertices, for_each_neighbor, newToOldIndex, vars, [&](int, const std::vector<int>& row) {
+            for (int x : row) {
+                a.index_.push_back(x);
                 a.value_.push_back(1);
-                cnt++;
-            }
-
-            for (;neigh_v_itt < neigh_v_itt_end; ++neigh_v_itt) {
-                if (mds_context.is_undetermined(newToOldIndex[*neigh_v_itt])) {
-                    //index.push_back(translation_pace_to_ilp[*neigh_v_itt]);
-                    a.index_.push_back(translation_pace_to_ilp[*neigh_v_itt]);
-                    a.value_.push_back(1);
-                    cnt++;
-                }
-                else {
-                    continue; //These decision variables have no influence.
-                }
-            }
-            if (cnt == 0) {
-                std::cout << "is_bad" << std::endl;
             }
-            HighsInt last = a.start_.back() + cnt;
+            HighsInt last = a.start_.back() + static_cast<HighsInt>(row.size());
             a.start_.push_back(last);
-        }
+        });
         ds_model.lp_.a_matrix_ = a;
 
         //create a highs instance
@@ -127,18 +94,34 @@ namespace operations_research {
             vector<int>selected_vertices;
             for (auto i = 0; i < num_vars; ++i) {
                 if (roundToInteger(solution.col_value[i]) == 1) { // is needed as there could be a very small int violation.
-                    selected_vertices.push_back(translation_ilp_to_pace[i]);
+                    selected_vertices.push_back(vars.vertex_of[i]);
                 }
             }
 
             return selected_vertices;
         }
         if (return_status == HighsStatus::kWarning) {
-            //time limit reached.
+            //time limit reached: take the incumbent, without one all undetermined vertices (always dominating, as the SAT path).
             Logger::timed_out = true;
-            return vector<int>();
+            const bool has_feasible = highs.getInfo().primal_solution_status == kSolutionStatusFeasible;
+            const HighsSolution& solution = highs.getSolution();
+            vector<int>selected_vertices;
+            for (auto i = 0; i < num_vars; ++i) {
+                if (!has_feasible || roundToInteger(solution.col_value[i]) == 1) {
+                    selected_vertices.push_back(vars.vertex_of[i]);
+                }
+            }
+            return selected_vertices;
         }
         //should never happen (set a breakpoint for sure);
-        throw new std::runtime_error("solver error");
+        throw std::runtime_error("solver error");
+    }
+
+    std::vector<int> ilp_solver(MDS_CONTEXT& mds_context, adjacencyListBoost& boost_graph, const std::vector<int>& newToOldIndex) {
+        return build_and_solve(mds_context, boost::num_vertices(boost_graph), domination_model::neighbors_of(boost_graph), newToOldIndex);
+    }
+
+    std::vector<int> ilp_solver(MDS_CONTEXT& mds_context, const SUBGRAPH_VIEW& view) {
+        return build_and_solve(mds_context, view.num_vertices(), domination_model::neighbors_of(view), view.local_to_global());
     }
-}  
\ No newline at end of file
+}
@@ -3,7 +3,10 @@
 
 namespace operations_research {
 
-    std::vector<int> ilp_solver(MDS_CONTEXT& mds_context, adjacencyListBoost& graph, std::unordered_map<int,int>& newToOldIndex);
+    std::vector<int> ilp_solver(MDS_CONTEXT& mds_context, adjacencyListBoost& graph, const std::vector<int>& newToOldIndex);
+
+    //view is a view of the graph of mds_context, the solution is in local vertices of the view.
+    std::vector<int> ilp_solver(MDS_CONTEXT& mds_context, const SUBGRAPH_VIEW& view);
 
     double roundToInteger(double value);
 }
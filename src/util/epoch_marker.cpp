@@ -0,0 +1,16 @@
+#include "epoch_marker.h"
+
+#include <algorithm>
+
+EPOCH_MARKER::EPOCH_MARKER() : epoch(0) {}
+
+void EPOCH_MARKER::clear(int size) {
+    if (stamp.size() < static_cast<std::size_t>(size)) {
+        stamp.resize(size, 0);
+        count_of.resize(size, 0);
+    }
+    if (++epoch == 0) {
+        std::fill(stamp.begin(), stamp.end(), 0);
+        epoch = 1;
+    }
+}
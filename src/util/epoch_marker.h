@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+//Set of integers in [0, size) with a counter per member, cleared in O(1).
+//a value is a member if its stamp is the current epoch, clear starts a new epoch (the arrays are only reset when the epoch wraps).
+//for the lookup tables of the neighborhood rules, which would otherwise allocate and zero an array of all vertices per call.
+class EPOCH_MARKER {
+public:
+    EPOCH_MARKER();
+
+    //removes all members, values in [0, size) can be inserted afterwards.
+    void clear(int size);
+
+    bool contains(int value) const { return stamp[value] == epoch; }
+
+    //values in [0, size()) can be inserted.
+    int size() const { return static_cast<int>(stamp.size()); }
+
+    void insert(int value) {
+        if (stamp[value] != epoch) {
+            stamp[value] = epoch;
+            count_of[value] = 0;
+        }
+    }
+
+    //counter of value, 0 if it is not a member.
+    int count(int value) const { return stamp[value] == epoch ? count_of[value] : 0; }
+
+    //inserts value and increments its counter.
+    int increment(int value) {
+        insert(value);
+        return ++count_of[value];
+    }
+
+private:
+    std::vector<std::uint32_t> stamp;
+    std::vector<int> count_of;
+    std::uint32_t epoch;
+};
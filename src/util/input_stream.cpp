@@ -0,0 +1,169 @@
+#include "input_stream.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <stdexcept>
+#include <unistd.h>
+#include <zlib.h>
+
+INPUT_STREAM::INPUT_STREAM(const std::string& path) : fd(-1), owns_fd(false), finished(false), stopped(false) {
+    if (path == "-") {
+        fd = STDIN_FILENO;
+    } else {
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1) {
+            throw std::invalid_argument("Failed to open file");
+        }
+        owns_fd = true;
+    }
+    reader = std::thread(&INPUT_STREAM::read_input, this);
+}
+
+INPUT_STREAM::~INPUT_STREAM() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped = true;
+    }
+    chunk_taken.notify_all();
+    //the reader stops after its current read() returns.
+    reader.join();
+    if (owns_fd) {
+        ::close(fd);
+    }
+}
+
+bool INPUT_STREAM::is_gzip(const char* begin, const char* end) {
+    return end - begin >= 2 && static_cast<unsigned char>(begin[0]) == 0x1f && static_cast<unsigned char>(begin[1]) == 0x8b;
+}
+
+bool INPUT_STREAM::next_chunk(std::vector<char>& chunk) {
+    std::unique_lock<std::mutex> lock(mutex);
+    chunk_ready.wait(lock, [this]() { return !queue.empty() || finished; });
+    if (queue.empty()) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return false;
+    }
+    chunk.swap(queue.front());
+    queue.pop_front();
+    lock.unlock();
+    chunk_taken.notify_one();
+    return true;
+}
+
+bool INPUT_STREAM::push_chunk(std::vector<char>&& chunk) {
+    std::unique_lock<std::mutex> lock(mutex);
+    chunk_taken.wait(lock, [this]() { return queue.size() < MAX_QUEUED_CHUNKS || stopped; });
+    if (stopped) {
+        return false;
+    }
+    queue.push_back(std::move(chunk));
+    lock.unlock();
+    chunk_ready.notify_one();
+    return true;
+}
+
+//fills block with up to CHUNK_SIZE bytes, a short block only happens at the end of the input.
+std::size_t INPUT_STREAM::read_block(std::vector<char>& block) {
+    block.resize(CHUNK_SIZE);
+    std::size_t filled = 0;
+    while (filled < CHUNK_SIZE) {
+        ssize_t bytes = ::read(fd, block.data() + filled, CHUNK_SIZE - filled);
+        if (bytes == 0) {
+            break;
+        }
+        if (bytes < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Failed to read input");
+        }
+        filled += bytes;
+    }
+    block.resize(filled);
+    return filled;
+}
+
+void INPUT_STREAM::read_input() {
+    try {
+        std::vector<char> block;
+        read_block(block);
+        //the format is detected on the content, pipes have no file extension.
+        if (is_gzip(block.data(), block.data() + block.size())) {
+            read_gzip(block);
+        } else {
+            read_plain(block);
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        error = std::current_exception();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished = true;
+    }
+    chunk_ready.notify_all();
+}
+
+void INPUT_STREAM::read_plain(std::vector<char>& block) {
+    while (!block.empty()) {
+        if (!push_chunk(std::move(block))) {
+            return;
+        }
+        block = std::vector<char>();
+        read_block(block);
+    }
+}
+
+void INPUT_STREAM::read_gzip(std::vector<char>& block) {
+    z_stream strm = {};
+    //15 + 32: maximal window, detect the gzip / zlib header automatically.
+    if (inflateInit2(&strm, 15 + 32) != Z_OK) {
+        throw std::runtime_error("Failed to initialize zlib");
+    }
+    std::vector<char> out(CHUNK_SIZE);
+    std::size_t out_filled = 0;
+    bool member_done = false;
+    try {
+        while (!block.empty()) {
+            strm.next_in = reinterpret_cast<Bytef*>(block.data());
+            strm.avail_in = static_cast<uInt>(block.size());
+            while (strm.avail_in > 0) {
+                //concatenated gzip members (e.g. cat a.gz b.gz) form one stream.
+                if (member_done) {
+                    inflateReset(&strm);
+                    member_done = false;
+                }
+                strm.next_out = reinterpret_cast<Bytef*>(out.data() + out_filled);
+                strm.avail_out = static_cast<uInt>(CHUNK_SIZE - out_filled);
+                int ret = inflate(&strm, Z_NO_FLUSH);
+                if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) {
+                    throw std::runtime_error("Corrupt gzip stream");
+                }
+                member_done = (ret == Z_STREAM_END);
+                out_filled = CHUNK_SIZE - strm.avail_out;
+                if (out_filled == CHUNK_SIZE) {
+                    if (!push_chunk(std::move(out))) {
+                        inflateEnd(&strm);
+                        return;
+                    }
+                    out = std::vector<char>(CHUNK_SIZE);
+                    out_filled = 0;
+                }
+            }
+            read_block(block);
+        }
+        if (!member_done) {
+            throw std::runtime_error("Truncated gzip stream");
+        }
+    } catch (...) {
+        inflateEnd(&strm);
+        throw;
+    }
+    inflateEnd(&strm);
+    if (out_filled > 0) {
+        out.resize(out_filled);
+        push_chunk(std::move(out));
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//Sequential reader for inputs that can not be memory mapped: stdin ("-"), FIFOs and gzip compressed instances.
+//A background thread reads (and if needed inflates) the input in large blocks, the caller consumes them with next_chunk.
+class INPUT_STREAM {
+public:
+    //size of a single read() and of the decompressed blocks handed to the caller.
+    static const std::size_t CHUNK_SIZE = 4 * 1024 * 1024;
+    //number of blocks the reader may run ahead of the parser.
+    static const std::size_t MAX_QUEUED_CHUNKS = 4;
+
+    //"-" reads stdin, throws std::invalid_argument if the path can not be opened.
+    explicit INPUT_STREAM(const std::string& path);
+
+    ~INPUT_STREAM();
+
+    INPUT_STREAM(const INPUT_STREAM&) = delete;
+    INPUT_STREAM& operator=(const INPUT_STREAM&) = delete;
+
+    //replaces chunk by the next block of (decompressed) input, returns false at the end of the input.
+    //errors of the background thread (read / corrupt gzip stream) are rethrown here.
+    bool next_chunk(std::vector<char>& chunk);
+
+    static bool is_gzip(const char* begin, const char* end);
+
+private:
+    int fd;
+    bool owns_fd;
+
+    std::thread reader;
+    std::mutex mutex;
+    std::condition_variable chunk_ready;
+    std::condition_variable chunk_taken;
+    std::deque<std::vector<char>> queue;
+    std::exception_ptr error;
+    bool finished;
+    bool stopped;
+
+    void read_input();
+
+    void read_plain(std::vector<char>& block);
+
+    void read_gzip(std::vector<char>& block);
+
+    std::size_t read_block(std::vector<char>& block);
+
+    //blocks while the queue is full, returns false if the consumer went away.
+    bool push_chunk(std::vector<char>&& chunk);
+};
@@ -0,0 +1,17 @@
+#include "local_index.h"
+
+#include <algorithm>
+
+LOCAL_INDEX::LOCAL_INDEX() : epoch(0), num_members(0) {}
+
+void LOCAL_INDEX::clear(int size) {
+    if (stamp.size() < static_cast<std::size_t>(size)) {
+        stamp.resize(size, 0);
+        local_id.resize(size, -1);
+    }
+    if (++epoch == 0) {
+        std::fill(stamp.begin(), stamp.end(), 0);
+        epoch = 1;
+    }
+    num_members = 0;
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+//Dense ids 0, 1, ... for the members of a small set of integers in [0, size), cleared in O(1).
+//the stamps work as in EPOCH_MARKER, for bitmasks over a neighborhood which would otherwise need a hash map to the bit.
+class LOCAL_INDEX {
+public:
+    LOCAL_INDEX();
+
+    //removes all members, values in [0, size) can be inserted afterwards.
+    void clear(int size);
+
+    //id of value, a new value gets the next id.
+    int insert(int value) {
+        if (stamp[value] != epoch) {
+            stamp[value] = epoch;
+            local_id[value] = num_members++;
+        }
+        return local_id[value];
+    }
+
+    //id of value, -1 if it is not a member.
+    int id(int value) const { return stamp[value] == epoch ? local_id[value] : -1; }
+
+    int size() const { return num_members; }
+
+private:
+    std::vector<std::uint32_t> stamp;
+    std::vector<int> local_id;
+    std::uint32_t epoch;
+    int num_members;
+};
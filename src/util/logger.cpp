@@ -47,6 +47,8 @@ void initialize_logger()
     Logger::num_edges = 0;
     Logger::num_reduced_vertices = 0;
     Logger::num_reduced_edges = 0;
+    Logger::cnt_duplicate_edges = 0;
+    Logger::cnt_self_loops = 0;
     Logger::cnt_dominated_vertices = 0;
     Logger::cnt_undetermined_vertices = 0;
     Logger::cnt_selected_vertices = 0;
@@ -54,6 +56,13 @@ void initialize_logger()
     Logger::cnt_excluded_vertices = 0;
     Logger::cnt_removed_vertices = 0;
 
+    //memory.
+    Logger::peak_rss_load = 0;
+    Logger::peak_rss_reduction = 0;
+    Logger::peak_rss_solver = 0;
+    Logger::max_context_bytes = 0;
+    Logger::instance_kept = false;
+
     //timer functions.
     Logger::execution_time_complete = 0;
     Logger::execution_time_treewidth = 0;
@@ -132,6 +141,8 @@ void initialize_logger_not_average()
     Logger::num_edges = 0;
     Logger::num_reduced_vertices = 0;
     Logger::num_reduced_edges = 0;
+    Logger::cnt_duplicate_edges = 0;
+    Logger::cnt_self_loops = 0;
     Logger::cnt_dominated_vertices = 0;
     Logger::cnt_undetermined_vertices = 0;
     Logger::cnt_selected_vertices = 0;
@@ -140,6 +151,13 @@ void initialize_logger_not_average()
     Logger::cnt_removed_vertices = 0;
     Logger::num_vertices_components.clear();
 
+    //memory.
+    Logger::peak_rss_load = 0;
+    Logger::peak_rss_reduction = 0;
+    Logger::peak_rss_solver = 0;
+    Logger::max_context_bytes = 0;
+    Logger::instance_kept = false;
+
     //timer functions.
     Logger::execution_time_complete = 0;
     Logger::execution_time_treewidth = 0;
@@ -220,6 +238,8 @@ void initialize_logger_not_average()
     int Logger::num_edges = 0;
     int Logger::num_reduced_vertices = 0;
     int Logger::num_reduced_edges = 0;
+    long long Logger::cnt_duplicate_edges = 0;
+    long long Logger::cnt_self_loops = 0;
     int Logger::cnt_undetermined_vertices = 0;
     int Logger::cnt_selected_vertices = 0;
     int Logger::cnt_dominated_vertices = 0;
@@ -227,6 +247,13 @@ void initialize_logger_not_average()
     int Logger::cnt_excluded_vertices = 0;
     int Logger::cnt_removed_vertices = 0;
 
+    //memory.
+    long long Logger::peak_rss_load = 0;
+    long long Logger::peak_rss_reduction = 0;
+    long long Logger::peak_rss_solver = 0;
+    long long Logger::max_context_bytes = 0;
+    bool Logger::instance_kept = false;
+
     //timer functions.
     long long Logger::execution_time_complete = 0;
     long long  Logger::execution_time_treewidth = 0;
@@ -261,6 +288,7 @@ void initialize_logger_not_average()
     strategy_reduction Logger::reduction_strategy = REDUCTION_COMBINATION;
     strategy_solver Logger::solver_strategy = SOLVER_COMBINATION;
     strategy_reduction_scheme Logger::reduction_scheme_strategy = REDUCTION_ALBER_L_NON;
+    strategy_relabel Logger::relabel_strategy = RELABEL_NON;
 
     int Logger::domination_number = 0;
 
@@ -302,6 +330,21 @@ std::string getSolverString(strategy_solver reduction) {
     }
 }
 
+std::string getRelabelString(strategy_relabel relabel) {
+    switch (relabel) {
+    case RELABEL_NON:
+        return "RELABEL_NON";
+    case RELABEL_RCM:
+        return "RELABEL_RCM";
+    case RELABEL_BFS:
+        return "RELABEL_BFS";
+    case RELABEL_DEGREE:
+        return "RELABEL_DEGREE";
+    default:
+        throw std::runtime_error("Unknown relabel strategy");
+    }
+}
+
 std::string getReductionSchemeString(strategy_reduction_scheme reduction) {
     switch (reduction) {
     case REDUCTION_ALBER_L_3:
@@ -334,6 +377,7 @@ void output_loginfo(std::string& name) {
     outFile << "Reduction strategy: " << getReductionString(Logger::reduction_strategy) << std::endl;
     outFile << "Solver strategy: " << getSolverString(Logger::solver_strategy) << std::endl;
     outFile << "Reduction scheme strategy: " << getReductionSchemeString(Logger::reduction_scheme_strategy) << std::endl;
+    outFile << "Relabel strategy: " << getRelabelString(Logger::relabel_strategy) << std::endl;
     //Timer
     outFile << "Execution time complete: " << Logger::execution_time_complete << std::endl;
     outFile << "Execution time reduction: " << Logger::execution_time_reduction << std::endl;
@@ -410,6 +454,8 @@ void output_loginfo(std::string& name) {
     outFile << "Number of edges: " << Logger::num_edges << std::endl;
     outFile << "Number of reduced_vertices: " << Logger::num_reduced_vertices << std::endl;
     outFile << "Number of reduced_edges: " << Logger::num_reduced_edges << std::endl;
+    outFile << "Number of removed duplicate edges: " << Logger::cnt_duplicate_edges << std::endl;
+    outFile << "Number of removed self loops: " << Logger::cnt_self_loops << std::endl;
     outFile << "Number of undetermined vertices: " << Logger::cnt_undetermined_vertices << std::endl;
     outFile << "Number of dominated vertices: " << Logger::cnt_dominated_vertices << std::endl;
     outFile << "Number of selected vertices: " << Logger::cnt_selected_vertices << std::endl;
@@ -417,6 +463,13 @@ void output_loginfo(std::string& name) {
     outFile << "Number of excluded vertices: " << Logger::cnt_excluded_vertices << std::endl;
     outFile << "Number of removed vertices: " << Logger::cnt_removed_vertices << std::endl;
 
+    //memory.
+    outFile << "Peak RSS after loading (KB): " << Logger::peak_rss_load << std::endl;
+    outFile << "Peak RSS after reduction (KB): " << Logger::peak_rss_reduction << std::endl;
+    outFile << "Peak RSS after solving (KB): " << Logger::peak_rss_solver << std::endl;
+    outFile << "Largest context (bytes): " << Logger::max_context_bytes << std::endl;
+    outFile << "Instance kept during the solve: " << (Logger::instance_kept ? "yes" : "no") << std::endl;
+
     //Components:
     outFile << "Number of components: " << Logger::num_components << std::endl;
     if (Logger::reduction_strategy != REDUCTION_NON){
@@ -25,6 +25,13 @@ enum strategy_reduction{
 	REDUCTION_L_ALBER,
 };
 
+enum strategy_relabel{
+	RELABEL_NON,
+	RELABEL_RCM,
+	RELABEL_BFS,
+	RELABEL_DEGREE,
+};
+
 enum strategy_reduction_scheme{
 	REDUCTION_ALBER_L_3,
 	REDUCTION_ALBER_L_4,
@@ -82,6 +89,8 @@ public:
 	static int num_edges;
 	static int num_reduced_vertices;
 	static int num_reduced_edges;
+	static long long cnt_duplicate_edges; // parallel edges dropped while loading the instance.
+	static long long cnt_self_loops;
 	static int cnt_undetermined_vertices;
 	static int cnt_selected_vertices;
 	static int cnt_dominated_vertices;
@@ -89,6 +98,13 @@ public:
 	static int cnt_excluded_vertices;
 	static int cnt_removed_vertices;
 
+	//memory, peak resident set size (KB) at the end of each stage.
+	static long long peak_rss_load;
+	static long long peak_rss_reduction;
+	static long long peak_rss_solver;
+	static long long max_context_bytes; // largest MDS_CONTEXT (graph + state) of a component.
+	static bool instance_kept; // the instance could not be read again (stdin, pipe) and was kept for the verification.
+
 	//timer functions.
 	static long long execution_time_complete;
 	static long long execution_time_treewidth;
@@ -115,6 +131,7 @@ public:
 	static strategy_reduction reduction_strategy;
 	static strategy_solver solver_strategy;
 	static strategy_reduction_scheme reduction_scheme_strategy;
+	static strategy_relabel relabel_strategy;
 
 	static std::vector<long long> average_SAT_execution_time;
 
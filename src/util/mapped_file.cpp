@@ -0,0 +1,97 @@
+#include "mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+MAPPED_FILE::MAPPED_FILE() : data(nullptr), length(0), mapped(false) {}
+
+MAPPED_FILE::MAPPED_FILE(const std::string& path) : MAPPED_FILE() {
+    open(path);
+}
+
+MAPPED_FILE::~MAPPED_FILE() {
+    close();
+}
+
+MAPPED_FILE::MAPPED_FILE(MAPPED_FILE&& other) noexcept : data(other.data), length(other.length), mapped(other.mapped) {
+    other.data = nullptr;
+    other.length = 0;
+    other.mapped = false;
+}
+
+MAPPED_FILE& MAPPED_FILE::operator=(MAPPED_FILE&& other) noexcept {
+    if (this != &other) {
+        close();
+        std::swap(data, other.data);
+        std::swap(length, other.length);
+        std::swap(mapped, other.mapped);
+    }
+    return *this;
+}
+
+bool MAPPED_FILE::open(const std::string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+    struct stat st;
+    //pipes & character devices can not be mapped, the caller has to stream those.
+    if (fstat(fd, &st) == -1 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+    length = st.st_size;
+    if (length == 0) {
+        //mmap does not accept empty files, an empty range is still a valid (empty) mapping.
+        ::close(fd);
+        mapped = true;
+        return true;
+    }
+    void* ptr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    //the mapping keeps its own reference to the file.
+    ::close(fd);
+    if (ptr == MAP_FAILED) {
+        length = 0;
+        return false;
+    }
+    //the parsers read front to back, let the kernel read ahead aggressively.
+    madvise(ptr, length, MADV_SEQUENTIAL);
+    data = static_cast<const char*>(ptr);
+    mapped = true;
+    return true;
+}
+
+void MAPPED_FILE::close() {
+    if (data != nullptr) {
+        munmap(const_cast<char*>(data), length);
+    }
+    data = nullptr;
+    length = 0;
+    mapped = false;
+}
+
+void MAPPED_FILE::advise_normal_access() const {
+    if (data != nullptr) {
+        madvise(const_cast<char*>(data), length, MADV_NORMAL);
+    }
+}
+
+bool MAPPED_FILE::is_open() const {
+    return mapped;
+}
+
+const char* MAPPED_FILE::begin() const {
+    return data;
+}
+
+const char* MAPPED_FILE::end() const {
+    return data + length;
+}
+
+std::size_t MAPPED_FILE::size() const {
+    return length;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <string>
+#include <cstddef>
+
+//Read-only memory mapping of a whole file (RAII, unmapped when it goes out of scope).
+class MAPPED_FILE {
+public:
+    MAPPED_FILE();
+
+    explicit MAPPED_FILE(const std::string& path);
+
+    ~MAPPED_FILE();
+
+    MAPPED_FILE(const MAPPED_FILE&) = delete;
+    MAPPED_FILE& operator=(const MAPPED_FILE&) = delete;
+
+    MAPPED_FILE(MAPPED_FILE&& other) noexcept;
+    MAPPED_FILE& operator=(MAPPED_FILE&& other) noexcept;
+
+    //returns false if the path can not be mapped (does not exist, or is not a regular file).
+    bool open(const std::string& path);
+
+    void close();
+
+    //the file is opened for one sequential scan, a mapping which is kept and read in any order drops that hint.
+    void advise_normal_access() const;
+
+    bool is_open() const;
+
+    const char* begin() const;
+
+    const char* end() const;
+
+    std::size_t size() const;
+
+private:
+    const char* data;
+    std::size_t length;
+    bool mapped;
+};
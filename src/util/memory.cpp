@@ -0,0 +1,12 @@
+#include "memory.h"
+
+#include <sys/resource.h>
+
+long long peak_rss_kb() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    //ru_maxrss is in KB on linux.
+    return usage.ru_maxrss;
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+//peak resident set size of the process in KB (high water mark since the start), 0 if it can not be read.
+long long peak_rss_kb();
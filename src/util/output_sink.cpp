@@ -0,0 +1,154 @@
+#include "output_sink.h"
+
+#include <cerrno>
+#include <charconv>
+#include <climits>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <stdexcept>
+#include <unistd.h>
+
+sink_kind OUTPUT_SINK::kind = SINK_DIRECTORY;
+std::string OUTPUT_SINK::directory = "";
+int OUTPUT_SINK::fd = -1;
+
+OUTPUT_BUFFER::OUTPUT_BUFFER() : buffer(4096), length(0) {}
+
+void OUTPUT_BUFFER::reserve(std::size_t size) {
+    if (size > buffer.size()) {
+        buffer.resize(size);
+    }
+}
+
+OUTPUT_BUFFER& OUTPUT_BUFFER::append(long long value) {
+    //20 characters fit every long long including the sign.
+    if (length + 20 > buffer.size()) {
+        buffer.resize(2 * buffer.size() + 20);
+    }
+    auto result = std::to_chars(buffer.data() + length, buffer.data() + buffer.size(), value);
+    length = result.ptr - buffer.data();
+    return *this;
+}
+
+OUTPUT_BUFFER& OUTPUT_BUFFER::append(char c) {
+    if (length == buffer.size()) {
+        buffer.resize(2 * buffer.size() + 1);
+    }
+    buffer[length++] = c;
+    return *this;
+}
+
+OUTPUT_BUFFER& OUTPUT_BUFFER::append(const std::string& text) {
+    return append(text.data(), text.size());
+}
+
+OUTPUT_BUFFER& OUTPUT_BUFFER::append(const char* text) {
+    return append(text, std::strlen(text));
+}
+
+OUTPUT_BUFFER& OUTPUT_BUFFER::append(const OUTPUT_BUFFER& other) {
+    return append(other.data(), other.size());
+}
+
+OUTPUT_BUFFER& OUTPUT_BUFFER::append(const char* text, std::size_t size) {
+    if (length + size > buffer.size()) {
+        buffer.resize(2 * buffer.size() + size);
+    }
+    std::memcpy(buffer.data() + length, text, size);
+    length += size;
+    return *this;
+}
+
+const char* OUTPUT_BUFFER::data() const {
+    return buffer.data();
+}
+
+std::size_t OUTPUT_BUFFER::size() const {
+    return length;
+}
+
+void OUTPUT_SINK::use_stdout() {
+    if (kind == SINK_STDOUT) {
+        return;
+    }
+    //the outputs keep a copy of stdout, the logging written to stdout afterwards ends up on stderr.
+    std::cout.flush();
+    std::fflush(stdout);
+    const int descriptor = ::dup(STDOUT_FILENO);
+    if (descriptor == -1 || ::dup2(STDERR_FILENO, STDOUT_FILENO) == -1) {
+        throw std::runtime_error("Failed to separate the output from the logging");
+    }
+    kind = SINK_STDOUT;
+    fd = descriptor;
+}
+
+void OUTPUT_SINK::use_directory(const std::string& path) {
+    kind = SINK_DIRECTORY;
+    directory = path;
+}
+
+void OUTPUT_SINK::use_fd(int descriptor) {
+    kind = SINK_FD;
+    fd = descriptor;
+}
+
+void OUTPUT_SINK::configure(const std::string& target) {
+    if (target == "-") {
+        use_stdout();
+    } else if (target.rfind("fd:", 0) == 0) {
+        const std::string number = target.substr(3);
+        char* end = nullptr;
+        errno = 0;
+        const long descriptor = std::strtol(number.c_str(), &end, 10);
+        if (number.empty() || *end != '\0' || errno != 0 || descriptor < 0 || descriptor > INT_MAX
+            || ::fcntl(static_cast<int>(descriptor), F_GETFD) == -1) {
+            throw std::invalid_argument("Not an open file descriptor: " + target);
+        }
+        if (descriptor == STDOUT_FILENO) {
+            use_stdout();
+        } else {
+            use_fd(static_cast<int>(descriptor));
+        }
+    } else {
+        use_directory(target);
+    }
+}
+
+static bool write_all(int descriptor, const char* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(descriptor, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= written;
+    }
+    return true;
+}
+
+bool OUTPUT_SINK::write(const std::string& name, const OUTPUT_BUFFER& buffer) {
+    if (kind != SINK_DIRECTORY) {
+        //text already buffered in std::cout has to come out first.
+        std::cout.flush();
+        return write_all(fd, buffer.data(), buffer.size());
+    }
+    std::string output_path = directory.empty() || directory.back() == '/' ? directory + name : directory + "/" + name;
+    return write_file(output_path, buffer);
+}
+
+bool OUTPUT_SINK::write_file(const std::string& path, const OUTPUT_BUFFER& buffer) {
+    int descriptor = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (descriptor == -1) {
+        printf("error with writing to file");
+        return false;
+    }
+    bool success = write_all(descriptor, buffer.data(), buffer.size());
+    ::close(descriptor);
+    return success;
+}
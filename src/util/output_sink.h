@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+enum sink_kind {
+    SINK_STDOUT,     // everything is written to stdout, the logging is moved to stderr.
+    SINK_DIRECTORY,  // every output gets its own file in a directory (the default, the working directory).
+    SINK_FD          // everything is written to an already opened file descriptor (pipe to the harness).
+};
+
+//Growing character buffer, integers are formatted with std::to_chars so nothing is flushed while it is filled.
+class OUTPUT_BUFFER {
+public:
+    OUTPUT_BUFFER();
+
+    void reserve(std::size_t size);
+
+    OUTPUT_BUFFER& append(long long value);
+
+    OUTPUT_BUFFER& append(char c);
+
+    OUTPUT_BUFFER& append(const std::string& text);
+
+    OUTPUT_BUFFER& append(const char* text);
+
+    OUTPUT_BUFFER& append(const OUTPUT_BUFFER& other);
+
+    const char* data() const;
+
+    std::size_t size() const;
+
+private:
+    std::vector<char> buffer;
+    std::size_t length;
+
+    OUTPUT_BUFFER& append(const char* text, std::size_t size);
+};
+
+//Destination of the solution, context and kernel writers (configured once in main).
+class OUTPUT_SINK {
+public:
+    static sink_kind kind;
+    static std::string directory;
+    static int fd;
+
+    //stdout is kept for the outputs only, from now on std::cout and printf write to stderr.
+    static void use_stdout();
+
+    static void use_directory(const std::string& path);
+
+    static void use_fd(int descriptor);
+
+    //"-" -> stdout, "fd:<n>" -> file descriptor n (an open descriptor, fd:1 is stdout), anything else is a directory.
+    static void configure(const std::string& target);
+
+    //writes the whole buffer with a single write() (repeated only on a partial write).
+    //name is the file name used by the directory sink.
+    static bool write(const std::string& name, const OUTPUT_BUFFER& buffer);
+
+    //writes the buffer to an explicit path (truncating), independent of the configured sink.
+    static bool write_file(const std::string& path, const OUTPUT_BUFFER& buffer);
+};
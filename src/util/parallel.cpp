@@ -0,0 +1,39 @@
+#include "parallel.h"
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+static int configured_threads = 1;
+
+int available_threads() {
+    return configured_threads;
+}
+
+void set_available_threads(int num_threads) {
+    configured_threads = std::max(1, num_threads);
+}
+
+void run_parallel(int num_threads, const std::function<void(int)>& task) {
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> errors(num_threads);
+    threads.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t]() {
+            try {
+                task(t);
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
@@ -0,0 +1,10 @@
+#pragma once
+#include <functional>
+
+//number of threads the parallel phases may use: the cores main binds itself to, one unless --threads=<n> is given.
+int available_threads();
+
+void set_available_threads(int num_threads);
+
+//runs task(thread_index) on num_threads threads, the first exception thrown by a task is rethrown.
+void run_parallel(int num_threads, const std::function<void(int)>& task);
@@ -0,0 +1,68 @@
+#include "sparse_set.h"
+
+#include <algorithm>
+
+SPARSE_SET::SPARSE_SET() {}
+
+SPARSE_SET::SPARSE_SET(int universe, bool filled) : position(universe, -1) {
+    if (filled) {
+        dense.resize(universe);
+        for (int value = 0; value < universe; ++value) {
+            dense[value] = value;
+            position[value] = value;
+        }
+    }
+}
+
+void SPARSE_SET::grow(bool insert_value) {
+    position.push_back(-1);
+    if (insert_value) {
+        insert(static_cast<int>(position.size()) - 1);
+    }
+}
+
+bool SPARSE_SET::contains(int value) const {
+    return position[value] >= 0;
+}
+
+void SPARSE_SET::insert(int value) {
+    if (position[value] >= 0) {
+        return;
+    }
+    position[value] = static_cast<int>(dense.size());
+    dense.push_back(value);
+}
+
+void SPARSE_SET::erase(int value) {
+    const int index = position[value];
+    if (index < 0) {
+        return;
+    }
+    const int last = dense.back();
+    dense[index] = last;
+    position[last] = index;
+    dense.pop_back();
+    position[value] = -1;
+}
+
+int SPARSE_SET::size() const {
+    return static_cast<int>(dense.size());
+}
+
+bool SPARSE_SET::empty() const {
+    return dense.empty();
+}
+
+std::vector<int> SPARSE_SET::sorted() const {
+    std::vector<int> members(dense);
+    std::sort(members.begin(), members.end());
+    return members;
+}
+
+std::vector<int>::const_iterator SPARSE_SET::begin() const {
+    return dense.begin();
+}
+
+std::vector<int>::const_iterator SPARSE_SET::end() const {
+    return dense.end();
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <vector>
+
+//Set of integers in [0, universe) with O(1) insert, erase and contains.
+//members are stored densely (unordered), erase swaps the member with the last one.
+class SPARSE_SET {
+public:
+    SPARSE_SET();
+
+    //all values in [0, universe) are members if filled.
+    explicit SPARSE_SET(int universe, bool filled);
+
+    //adds value universe (the universe grows by one), as a member if insert.
+    void grow(bool insert);
+
+    bool contains(int value) const;
+
+    void insert(int value);
+
+    void erase(int value);
+
+    int size() const;
+
+    bool empty() const;
+
+    //members in ascending order.
+    std::vector<int> sorted() const;
+
+    std::vector<int>::const_iterator begin() const;
+
+    std::vector<int>::const_iterator end() const;
+
+private:
+    std::vector<int> dense;
+    std::vector<int> position;  // index in dense, -1 if not a member.
+};
@@ -0,0 +1,222 @@
+#include "verifier.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+#include "graph/graph_io.h"
+#include "util/mapped_file.h"
+
+namespace verifier {
+    //one bit per vertex.
+    class BITSET {
+    public:
+        explicit BITSET(int n) : words((n + 63) / 64, 0), num_bits(n) {}
+
+        bool test(int v) const {
+            return (words[v >> 6] >> (v & 63)) & 1;
+        }
+
+        void set(int v) {
+            words[v >> 6] |= std::uint64_t(1) << (v & 63);
+        }
+
+        //first vertex which is not set, -1 if all are set.
+        int first_unset() const {
+            for (std::size_t w = 0; w < words.size(); ++w) {
+                std::uint64_t missing = ~words[w];
+                if (w == words.size() - 1 && (num_bits & 63) != 0) {
+                    missing &= (std::uint64_t(1) << (num_bits & 63)) - 1;
+                }
+                if (missing != 0) {
+                    return static_cast<int>(w * 64 + __builtin_ctzll(missing));
+                }
+            }
+            return -1;
+        }
+
+    private:
+        std::vector<std::uint64_t> words;
+        int num_bits;
+    };
+
+    //one line of a solution file, split at blanks.
+    static std::vector<std::string> split_line(const char* begin, const char* end) {
+        std::vector<std::string> tokens;
+        while (begin < end) {
+            while (begin < end && (*begin == ' ' || *begin == '\t' || *begin == '\r')) ++begin;
+            const char* token_begin = begin;
+            while (begin < end && *begin != ' ' && *begin != '\t' && *begin != '\r') ++begin;
+            if (begin > token_begin) {
+                tokens.emplace_back(token_begin, begin);
+            }
+        }
+        return tokens;
+    }
+
+    //only plain decimal digits, no sign, fraction or trailing characters.
+    static bool parse_unsigned(const std::string& token, long long& value) {
+        if (token.empty() || token.size() > 18) {
+            return false;
+        }
+        value = 0;
+        for (char c : token) {
+            if (c < '0' || c > '9') {
+                return false;
+            }
+            value = value * 10 + (c - '0');
+        }
+        return true;
+    }
+
+    std::vector<int> read_solution(const std::string& path, int num_vertices) {
+        MAPPED_FILE file;
+        std::string buffer;
+        const char* cur;
+        const char* end;
+        if (file.open(path)) {
+            cur = file.begin();
+            end = file.end();
+        } else {
+            std::ifstream f(path, std::ios::binary);
+            if (f.fail()) {
+                throw std::invalid_argument("Failed to open file");
+            }
+            buffer.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+            cur = buffer.data();
+            end = buffer.data() + buffer.size();
+        }
+
+        std::vector<int> solution;
+        long long expected_size = -1;
+        int line_number = 0;
+        while (cur < end) {
+            const void* newline = std::memchr(cur, '\n', end - cur);
+            const char* line_end = (newline == nullptr) ? end : static_cast<const char*>(newline);
+            std::vector<std::string> tokens = split_line(cur, line_end);
+            cur = (newline == nullptr) ? end : line_end + 1;
+            line_number++;
+            if (tokens.empty() || tokens[0][0] == 'c') {
+                continue;
+            }
+            const std::string where = "line " + std::to_string(line_number) + ": ";
+            long long value;
+            if (tokens.size() != 1 || !parse_unsigned(tokens[0], value)) {
+                throw std::invalid_argument(where + "expected a single unsigned integer");
+            }
+            if (expected_size == -1) {
+                if (value > num_vertices) {
+                    throw std::invalid_argument(where + "solution size " + tokens[0] + " is larger than the graph");
+                }
+                expected_size = value;
+                solution.reserve(expected_size);
+                continue;
+            }
+            if (value < 1 || value > num_vertices) {
+                throw std::invalid_argument(where + "vertex " + tokens[0] + " is not in 1.." + std::to_string(num_vertices));
+            }
+            solution.push_back(static_cast<int>(value));
+        }
+        if (expected_size == -1) {
+            throw std::invalid_argument("Solution size line is missing");
+        }
+        if (expected_size != static_cast<long long>(solution.size())) {
+            throw std::invalid_argument("Solution size " + std::to_string(expected_size) + " does not match the " + std::to_string(solution.size()) + " vertices in the file");
+        }
+        return solution;
+    }
+
+    verification_result verify_dominating_set(const CSR_GRAPH& csr, const std::vector<int>& solution) {
+        verification_result result = { true, static_cast<int>(solution.size()), -1, 0, false, "" };
+        BITSET selected(csr.num_vertices);
+        BITSET dominated(csr.num_vertices);
+        for (int v : solution) {
+            if (v < 1 || v > csr.num_vertices) {
+                result.valid = false;
+                result.message = "vertex " + std::to_string(v) + " is not in the graph";
+                return result;
+            }
+            if (selected.test(v - 1)) {
+                result.valid = false;
+                result.message = "vertex " + std::to_string(v) + " is in the solution twice";
+                return result;
+            }
+            selected.set(v - 1);
+            dominated.set(v - 1);
+            auto [neigh_itt, neigh_itt_end] = csr.get_neighborhood(v - 1);
+            for (; neigh_itt != neigh_itt_end; ++neigh_itt) {
+                dominated.set(*neigh_itt);
+            }
+        }
+        int undominated = dominated.first_unset();
+        if (undominated != -1) {
+            result.valid = false;
+            result.first_undominated = undominated + 1;
+            result.message = "vertex " + std::to_string(undominated + 1) + " is not dominated";
+        }
+        return result;
+    }
+
+    bool verify_lower_bound(const CSR_GRAPH& csr, const std::vector<int>& certificate, verification_result& result) {
+        //closed neighborhoods of a 2-packing are disjoint, so every vertex is covered at most once.
+        BITSET covered(csr.num_vertices);
+        for (int p : certificate) {
+            if (p < 1 || p > csr.num_vertices || covered.test(p - 1)) {
+                result.message = "certificate is not a 2-packing (vertex " + std::to_string(p) + ")";
+                return false;
+            }
+            covered.set(p - 1);
+            auto [neigh_itt, neigh_itt_end] = csr.get_neighborhood(p - 1);
+            for (; neigh_itt != neigh_itt_end; ++neigh_itt) {
+                if (*neigh_itt == static_cast<std::uint32_t>(p - 1)) {
+                    continue; // self loop.
+                }
+                if (covered.test(*neigh_itt)) {
+                    result.message = "certificate is not a 2-packing (vertex " + std::to_string(p) + ")";
+                    return false;
+                }
+                covered.set(*neigh_itt);
+            }
+        }
+        result.lower_bound = certificate.size();
+        result.optimal = result.valid && result.lower_bound == result.size;
+        return true;
+    }
+
+    verification_result verify_solution_file(const std::string& graph_path, const std::string& solution_path, const std::string& certificate_path) {
+        //no .grb cache is read or written, verifying has no side effects.
+        CSR_GRAPH csr = parse::load_pace_2024_csr(graph_path, parse::PARSE_MMAP_PARALLEL, false);
+        verification_result result = { false, 0, -1, 0, false, "" };
+        try {
+            result = verify_dominating_set(csr, read_solution(solution_path, csr.num_vertices));
+        } catch (const std::invalid_argument& e) {
+            result.message = "malformed solution file, " + std::string(e.what());
+            return result;
+        }
+        if (!certificate_path.empty()) {
+            try {
+                verify_lower_bound(csr, read_solution(certificate_path, csr.num_vertices), result);
+            } catch (const std::invalid_argument& e) {
+                result.message = "malformed certificate file, " + std::string(e.what());
+            }
+        }
+        return result;
+    }
+
+    void print_verification(const verification_result& result) {
+        if (result.valid) {
+            std::cout << "valid dominating set of size " << result.size;
+        } else {
+            std::cout << "INVALID solution: " << result.message;
+        }
+        if (result.lower_bound > 0) {
+            std::cout << ", lower bound " << result.lower_bound << (result.optimal ? " (optimal)" : "");
+        } else if (result.valid && !result.message.empty()) {
+            std::cout << ", " << result.message;
+        }
+        std::cout << std::endl;
+    }
+}
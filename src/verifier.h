@@ -0,0 +1,34 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "graph/csr_graph.h"
+
+//Checks solutions against the original instance, with a dense bitset in O(n + m).
+namespace verifier {
+    struct verification_result {
+        bool valid;
+        int size;                 // number of vertices in the solution.
+        int first_undominated;    // 1 indexed, -1 if every vertex is dominated.
+        int lower_bound;          // size of the verified certificate, 0 without a certificate.
+        bool optimal;             // the certificate proves the solution is optimal.
+        std::string message;
+    };
+
+    //reads a PACE solution (first line the size, then one 1 indexed vertex per line, c lines are comments).
+    //throws std::invalid_argument on anything but one unsigned integer per line, vertices outside 1..num_vertices,
+    //or a size line which does not match the number of vertices.
+    std::vector<int> read_solution(const std::string& path, int num_vertices);
+
+    //solution is 1 indexed (as written by output_solution).
+    verification_result verify_dominating_set(const CSR_GRAPH& csr, const std::vector<int>& solution);
+
+    //certificate: a 2-packing (1 indexed vertices with pairwise disjoint closed neighborhoods).
+    //every dominating set contains a vertex of each of those neighborhoods, so its size is a lower bound.
+    bool verify_lower_bound(const CSR_GRAPH& csr, const std::vector<int>& certificate, verification_result& result);
+
+    //loads the instance and the .sol file, certificate_path may be empty.
+    verification_result verify_solution_file(const std::string& graph_path, const std::string& solution_path, const std::string& certificate_path);
+
+    void print_verification(const verification_result& result);
+}
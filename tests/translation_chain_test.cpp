@@ -0,0 +1,93 @@
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "../src/graph/translation_chain.h"
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+int main() {
+    //component of the instance: vertices 0, 1, 2 are the vertices 4, 7, 9 of the instance.
+    const index_map component = { 4, 7, 9 };
+    //reduced component: vertices 0, 1 are the vertices 2, 0 of the component, vertex 2 is a gadget vertex.
+    const index_map reduced = { 2, 0 };
+
+    TRANSLATION_CHAIN chain;
+    chain.push_layer(component);
+    chain.push_layer(reduced);
+
+    check(chain.translate(0) == 9, "translate(0)");
+    check(chain.translate(1) == 4, "translate(1)");
+    check(chain.translate(2) == -1, "gadget vertex translates to -1");
+    check(chain.solution_vertex(0) == 10, "solution_vertex(0)");
+    check(chain.solution_vertex(1) == 5, "solution_vertex(1)");
+
+    bool thrown = false;
+    try {
+        chain.solution_vertex(2);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    check(thrown, "solution_vertex of a gadget vertex throws");
+
+    std::vector<int> solution;
+    chain.lift({ 1, 0 }, solution);
+    check(solution == std::vector<int>({ 5, 10 }), "lift");
+
+    //a gadget vertex in the solution is never written out as vertex 0.
+    thrown = false;
+    solution.clear();
+    try {
+        chain.lift({ 0, 2 }, solution);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    check(thrown, "lift with a gadget vertex throws");
+    for (int v : solution) {
+        check(v > 0, "lifted vertex is 1 indexed");
+    }
+
+    //three levels, the middle layer has a gadget vertex (-1): a deeper vertex mapped onto it stays a gadget vertex.
+    const index_map with_gadget = { 2, -1, 0 };
+    const index_map deepest = { 1, 2, 0, 3 };
+    TRANSLATION_CHAIN nested;
+    nested.push_layer(component);
+    nested.push_layer(with_gadget);
+    nested.push_layer(deepest);
+
+    const index_map composed = nested.compose();
+    check(composed == index_map({ -1, 4, 9, -1 }), "compose");
+    for (std::int32_t v = 0; v < static_cast<std::int32_t>(composed.size()); ++v) {
+        check(composed[v] == nested.translate(v), "compose agrees with translate");
+    }
+
+    solution.clear();
+    nested.lift({ 1, 2 }, solution);
+    check(solution == std::vector<int>({ 5, 10 }), "lift after compose");
+
+    //vertex 0 reaches the gadget vertex of the middle layer, vertex 3 is outside it.
+    for (int gadget : { 0, 3 }) {
+        thrown = false;
+        solution.clear();
+        try {
+            nested.lift({ gadget }, solution);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        check(thrown, "lift of a composed gadget vertex throws");
+    }
+
+    if (failures > 0) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "translation_chain: ok" << std::endl;
+    return EXIT_SUCCESS;
+}